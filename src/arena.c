@@ -0,0 +1,39 @@
+#include <string.h>
+#include "arena.h"
+
+Arena arena;
+static uint8_t currentMode = ARENA_MENU;
+
+// The shared prefix has to line up in every game overlay
+_Static_assert(offsetof(PlayOverlay, sprite) == offsetof(EffectOverlay, sprite), "sprite moves between overlays");
+_Static_assert(offsetof(PlayOverlay, portalRow) == offsetof(EffectOverlay, portalRow), "portal row moves between overlays");
+_Static_assert(offsetof(PlayOverlay, practice) == offsetof(EffectOverlay, practice), "checkpoints move between overlays");
+_Static_assert(offsetof(PlayOverlay, portalParts) == offsetof(EffectOverlay, particles), "shared prefix differs between overlays");
+
+// Each overlay has what the glyph scratch leaves of the budget, so the one
+// that outgrows it is named
+#define OVERLAY_ROOM (ARENA_BUDGET - sizeof(((Arena *)0)->glyph))
+_Static_assert(sizeof(MenuOverlay) <= OVERLAY_ROOM, "menu overlay over budget");
+_Static_assert(sizeof(PlayOverlay) <= OVERLAY_ROOM, "play overlay over budget");
+_Static_assert(sizeof(EffectOverlay) <= OVERLAY_ROOM, "death/win overlay over budget");
+_Static_assert(sizeof(Arena) <= ARENA_BUDGET, "arena over budget");
+
+// Bytes at the front of the overlays carried from one mode to the next
+#define ARENA_SHARED offsetof(PlayOverlay, portalParts)
+
+void arenaEnter(uint8_t mode)
+{
+	if (mode == currentMode)
+		return;
+#if ARENA_POISON
+	// Menu keeps nothing; between game modes only the shared prefix lives on
+	size_t keep = (mode == ARENA_MENU || currentMode == ARENA_MENU) ? 0 : ARENA_SHARED;
+	memset((uint8_t *)&arena.mode + keep, ARENA_POISON_BYTE, sizeof(arena.mode) - keep);
+#endif
+	currentMode = mode;
+}
+
+uint8_t arenaMode(void)
+{
+	return currentMode;
+}
@@ -0,0 +1,92 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <stdint.h>
+#include <stddef.h>
+#include "game.h"
+#include "effects.h"
+#include "widget.h"
+#include "bench.h"
+#include "practice.h"
+#include "upload.h"
+
+// ============================================
+// RAM ARENA
+// The big buffers are never all needed at once, so they share one static
+// block.  Each mode has an overlay describing its buffers; entering a mode
+// with arenaEnter() hands the block over to that overlay.
+//
+//   common   glyph scratch for the text routines, valid in every mode
+//   menu     the widgets of the screen showing (ui.c), and the level
+//            upload frame coming in (upload.c)
+//   play     player sprite, portal row strip, practice checkpoints, portal
+//            sparks, and the field benchmark table (bench.h)
+//   death    player sprite, portal row strip, practice checkpoints,
+//            scatter particles
+//   win      same layout as death
+//
+// The sprite, portal row and checkpoints sit at the front of every game
+// overlay so they survive play -> death -> play and play -> win; the
+// asserts in arena.c keep it that way.  Build with -DARENA_POISON=1 to fill everything a mode
+// switch releases with ARENA_POISON_BYTE, so a stale pointer into the old
+// overlay shows up as garbage on screen instead of working by luck.
+// ============================================
+#ifndef ARENA_POISON
+#define ARENA_POISON 0
+#endif
+#define ARENA_POISON_BYTE 0xa5
+
+enum {
+	ARENA_MENU,
+	ARENA_PLAY,
+	ARENA_DEATH,
+	ARENA_WIN
+};
+
+// Enough for one printTextX2 glyph (5x7 font at scale 2)
+#define ARENA_GLYPH_PIXELS (5 * 7 * 2 * 2)
+
+// Most widgets a menu screen has
+#define MENU_WIDGETS 8
+
+typedef struct {
+	Widget widgets[MENU_WIDGETS];
+	uint8_t uploadFrame[UPLOAD_FRAME_MAX];
+} MenuOverlay;
+
+typedef struct {
+	uint16_t sprite[ROT_SIZE * ROT_SIZE];  // rotated player
+	uint16_t portalRow[PORTAL_WIDTH];      // one row of the portal, sent in a single putImage
+	PracticeRing practice;                 // practice.h
+	PortalParticle portalParts[MAX_PORTAL_PARTICLES];
+#if BENCH_ENABLED
+	BenchResult bench[BENCH_TESTS];
+#endif
+} PlayOverlay;
+
+typedef struct {
+	uint16_t sprite[ROT_SIZE * ROT_SIZE];
+	uint16_t portalRow[PORTAL_WIDTH];
+	PracticeRing practice;
+	Particle particles[MAX_PARTICLES];
+} EffectOverlay;
+
+typedef struct {
+	uint16_t glyph[ARENA_GLYPH_PIXELS];
+	union {
+		MenuOverlay menu;
+		PlayOverlay play;
+		EffectOverlay effect; // death and win
+	} mode;
+} Arena;
+
+// Everything above has to fit in this; raise it knowingly
+#define ARENA_BUDGET 2408
+
+extern Arena arena;
+
+// Switch the arena to a mode.  Buffers of the old mode that the new one
+// doesn't share are released (and poisoned in ARENA_POISON builds).
+void arenaEnter(uint8_t mode);
+uint8_t arenaMode(void);
+
+#endif
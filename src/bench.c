@@ -0,0 +1,135 @@
+#include "bench.h"
+
+#if BENCH_ENABLED
+#include "arena.h"
+#include "display.h"
+
+static const char *const benchNames[BENCH_TESTS] = {
+	"FILL", "BLIT", "TEXT", "PLOT", "ROT", "PORT", "GAME"
+};
+
+// Captured from the serial port after a clean run of level 3:
+//   REPLAY 2 01234567 549 e9b46c09 100116010d01...
+const Replay benchScript = {
+	.level = 2,
+	.truncated = 0,
+	.state = 0,
+	.length = 36,
+	.seed = 0x01234567,
+	.ticks = 549,
+	.lastToggle = 514,
+	.data = {
+		0x10, 0x01, 0x16, 0x01, 0x0d, 0x01, 0x0d, 0x01, 0x11, 0x01, 0x15, 0x01,
+		0x39, 0x01, 0x10, 0x01, 0x10, 0x01, 0x39, 0x01, 0x0d, 0x01, 0x0d, 0x01,
+		0x17, 0x01, 0x48, 0x01, 0x16, 0x01, 0x3e, 0x01, 0x10, 0x01, 0x1b, 0x01
+	}
+};
+
+void benchReset(void)
+{
+	for (int i = 0; i < BENCH_TESTS; i++)
+	{
+		BenchResult *r = &arena.mode.play.bench[i];
+		r->frames = 0;
+		r->pixels = 0;
+		r->us = 0;
+	}
+}
+void benchAdd(BenchTest test, uint32_t frames, uint32_t pixels, uint32_t us)
+{
+	BenchResult *r = &arena.mode.play.bench[test];
+	r->frames += frames;
+	r->pixels += pixels;
+	r->us += us;
+}
+const BenchResult *benchResult(BenchTest test)
+{
+	return &arena.mode.play.bench[test];
+}
+
+static uint32_t kiloPixelsPerSecond(const BenchResult *r)
+{
+	// pixels / us * 1000 without overflowing: a second of FILL is a few million pixels
+	return r->us ? (uint32_t)((uint64_t)r->pixels * 1000u / r->us) : 0;
+}
+static uint32_t tenthsMsPerFrame(const BenchResult *r)
+{
+	return r->frames ? (r->us / r->frames + 50) / 100 : 0;
+}
+// "123.4" style, right aligned in width characters
+static char *putTenths(char *p, uint32_t tenths, int width)
+{
+	char tmp[12];
+	int n = 0;
+	tmp[n++] = (char)('0' + tenths % 10);
+	tmp[n++] = '.';
+	tenths /= 10;
+	do
+	{
+		tmp[n++] = (char)('0' + tenths % 10);
+		tenths /= 10;
+	} while (tenths && n < (int)sizeof(tmp));
+	while (width-- > n) *p++ = ' ';
+	while (n > 0) *p++ = tmp[--n];
+	return p;
+}
+static char *putUnsigned(char *p, uint32_t value, int width)
+{
+	char tmp[10];
+	int n = 0;
+	do
+	{
+		tmp[n++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+	while (width-- > n) *p++ = ' ';
+	while (n > 0) *p++ = tmp[--n];
+	return p;
+}
+
+void benchDrawScreen(void)
+{
+	uint16_t fg = RGBToWord(0xff, 0xff, 0xff);
+	uint16_t hdr = RGBToWord(0xff, 0xff, 0x00);
+	fillRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+	printText("BENCH", 2, 2, hdr, 0);
+	printText("KPX/S", SCREEN_WIDTH - 84, 2, hdr, 0);
+	printText("MS/F", SCREEN_WIDTH - 36, 2, hdr, 0);
+	for (int i = 0; i < BENCH_TESTS; i++)
+	{
+		const BenchResult *r = &arena.mode.play.bench[i];
+		uint16_t rowY = (uint16_t)(14 + 12 * i);
+		char text[8];
+		printText(benchNames[i], 2, rowY, fg, 0);
+		*putUnsigned(text, kiloPixelsPerSecond(r), 5) = 0;
+		printText(text, SCREEN_WIDTH - 84, rowY, fg, 0);
+		*putTenths(text, tenthsMsPerFrame(r), 6) = 0;
+		printText(text, SCREEN_WIDTH - 42, rowY, fg, 0);
+	}
+	printText("ANY KEY: MENU", 2, (uint16_t)(14 + 12 * BENCH_TESTS + 4), hdr, 0);
+}
+
+void benchReport(void (*writeLine)(const char *line))
+{
+	char line[64];
+	writeLine("test    frames   pixels       us  kpx_s  ms_frame\r\n");
+	for (int i = 0; i < BENCH_TESTS; i++)
+	{
+		const BenchResult *r = &arena.mode.play.bench[i];
+		char *p = line;
+		const char *n = benchNames[i];
+		int len = 0;
+		while (n[len]) { *p++ = n[len]; len++; }
+		while (len++ < 6) *p++ = ' ';
+		p = putUnsigned(p, r->frames, 8);
+		p = putUnsigned(p, r->pixels, 9);
+		p = putUnsigned(p, r->us, 9);
+		p = putUnsigned(p, kiloPixelsPerSecond(r), 7);
+		p = putTenths(p, tenthsMsPerFrame(r), 10);
+		*p++ = '\r';
+		*p++ = '\n';
+		*p = 0;
+		writeLine(line);
+	}
+}
+#endif
@@ -0,0 +1,65 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <stdint.h>
+#include "replay.h"
+
+// ============================================
+// FIELD BENCHMARK
+// Hidden menu entry: hold RIGHT and press PAUSE (RIGHT let go on its own
+// toggles practice mode instead).  Each drawing kernel runs flat out for
+// BENCH_TEST_US, then the built-in recording of level 3 plays through the
+// normal game loop for BENCH_GAME_US at full quality.  The table goes on
+// screen and out of the serial port, so a board's real panel throughput
+// can be checked without a debugger.
+//
+//   KPX/S  thousand pixels per second
+//   MS/F   milliseconds per frame: one call for the kernels (PLOT: 256
+//          pixels), one rendered frame without the pacing sleep for GAME
+//
+// Pixel counts are the pixels each kernel writes; TEXT, PORT and GAME
+// draw shapes that aren't known up front, so for those it is the panel
+// bus traffic over two bytes per pixel (command overhead included).
+// Set BENCH_ENABLED to 0 to leave it out of the firmware.
+// ============================================
+#ifndef BENCH_ENABLED
+#define BENCH_ENABLED 1
+#endif
+
+#if BENCH_ENABLED
+
+#define BENCH_TEST_US 1000000u
+#define BENCH_GAME_US 10000000u
+
+typedef enum {
+	BENCH_FILL,    // full screen fillRectangle
+	BENCH_BLIT,    // 16x16 putImage
+	BENCH_TEXT,    // printText, one line of 16 characters
+	BENCH_PLOT,    // putPixel
+	BENCH_ROTATE,  // computeSmoothRotatedSprite (into RAM, nothing drawn)
+	BENCH_PORTAL,  // drawProceduralPortal
+	BENCH_GAME,    // scripted gameplay
+	BENCH_TESTS
+} BenchTest;
+
+typedef struct {
+	uint32_t frames;
+	uint32_t pixels;
+	uint32_t us;
+} BenchResult;
+
+// Level 3 played to the portal; the first BENCH_GAME_US of it is used
+extern const Replay benchScript;
+
+// The table is kept in the play overlay of the RAM arena (arena.h): reset
+// it after arenaEnter(ARENA_PLAY), and be done with it before play mode is left
+void benchReset(void);
+void benchAdd(BenchTest test, uint32_t frames, uint32_t pixels, uint32_t us);
+const BenchResult *benchResult(BenchTest test);
+// Full screen results table
+void benchDrawScreen(void);
+// Same table one text line at a time, e.g. to the serial port
+void benchReport(void (*writeLine)(const char *line));
+
+#endif
+
+#endif
@@ -0,0 +1,23 @@
+#include "crc.h"
+
+uint8_t crc8(const uint8_t *data, uint16_t len)
+{
+	uint8_t crc = 0;
+	while (len--)
+	{
+		crc ^= *data++;
+		for (int i = 0; i < 8; i++)
+			crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+	}
+	return crc;
+}
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+	while (len--)
+	{
+		crc ^= (uint16_t)(*data++ << 8);
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+	}
+	return crc;
+}
@@ -0,0 +1,16 @@
+#ifndef CRC_H
+#define CRC_H
+#include <stdint.h>
+
+// ============================================
+// CRC
+// Bitwise, no tables: the checks are short and flash is tight.
+// ============================================
+
+// CRC-8 (poly 0x07, starting from 0): telemetry records
+uint8_t crc8(const uint8_t *data, uint16_t len);
+// CRC-16 (CCITT, poly 0x1021), carried on from crc: start with 0xffff.
+// The key-value store and level uploads check with it.
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+#endif
@@ -1,14 +1,28 @@
-void display_begin(void);
-void delay(uint32_t dly);
-void fillRectangle(uint16_t x,uint16_t y,uint16_t width, uint16_t height, uint16_t colour);
-void putPixel(uint16_t x, uint16_t y, uint16_t colour);
-void putImage(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *Image, int hOrientation,int vOrientation);
-void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t Colour);
-void drawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Colour);
-void drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t Colour);
-void fillCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t Colour);
-void printText(const char *Text,uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
-void printTextX2(const char *Text, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
-void printNumber(uint16_t Number, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
-void printNumberX2(uint16_t Number, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
-uint16_t RGBToWord(uint16_t R, uint16_t G, uint16_t B);
\ No newline at end of file
+#include <stdint.h>
+#include "display_config.h"
+#include "ramfunc.h"
+
+void display_begin(void);
+RAMFUNC void fillRectangle(uint16_t x,uint16_t y,uint16_t width, uint16_t height, uint16_t colour);
+void putPixel(uint16_t x, uint16_t y, uint16_t colour);
+RAMFUNC void putImage(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *Image, int hOrientation,int vOrientation);
+void putImageRLE(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *Palette, const uint8_t *Runs);
+void putImageRLEWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *Palette, const uint8_t *Runs,
+	uint16_t wx, uint16_t wy, uint16_t ww, uint16_t wh);
+void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t Colour);
+void drawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Colour);
+void drawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t Colour);
+void fillCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t Colour);
+void printText(const char *Text,uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
+void printTextX2(const char *Text, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
+void printNumber(uint16_t Number, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
+void printNumberX2(uint16_t Number, uint16_t x, uint16_t y, uint16_t ForeColour, uint16_t BackColour);
+uint16_t RGBToWord(uint16_t R, uint16_t G, uint16_t B);
+
+// Bytes sent to the panel since reset (commands, parameters and pixels).
+// Free running: take the difference across a frame.
+extern uint32_t displayBusBytes;
+
+#if DISPLAY_DRIVER == DISPLAY_DRIVER_HOSTFB
+extern uint16_t hostFramebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+#endif
@@ -0,0 +1,50 @@
+#ifndef DISPLAY_CONFIG_H
+#define DISPLAY_CONFIG_H
+
+// ============================================
+// DISPLAY PROFILES
+// Pick one at compile time with -DDISPLAY_PROFILE=<n> in platformio.ini.
+// A profile fixes the screen geometry, the panel orientation and which
+// driver display.c is built against. The driver is chosen by the
+// preprocessor, so there is no function pointer between the drawing code
+// and the bus.
+// ============================================
+#define DISPLAY_PROFILE_ST7735_LANDSCAPE 0 // 160x128, the original wiring
+#define DISPLAY_PROFILE_ST7735_PORTRAIT  1 // 128x160, same panel turned 90 degrees
+#define DISPLAY_PROFILE_HOST             2 // 160x128 framebuffer in RAM for host builds
+
+// Drivers
+#define DISPLAY_DRIVER_ST7735 0
+#define DISPLAY_DRIVER_HOSTFB 1
+
+#ifndef DISPLAY_PROFILE
+#define DISPLAY_PROFILE DISPLAY_PROFILE_ST7735_LANDSCAPE
+#endif
+
+#if DISPLAY_PROFILE == DISPLAY_PROFILE_ST7735_LANDSCAPE
+#define SCREEN_WIDTH 160
+#define SCREEN_HEIGHT 128
+#define DISPLAY_DRIVER DISPLAY_DRIVER_ST7735
+#define DISPLAY_MADCTL 0xa8 // row/column exchange, row flip, BGR
+#elif DISPLAY_PROFILE == DISPLAY_PROFILE_ST7735_PORTRAIT
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 160
+#define DISPLAY_DRIVER DISPLAY_DRIVER_ST7735
+#define DISPLAY_MADCTL 0xc8 // row and column flip, BGR
+#elif DISPLAY_PROFILE == DISPLAY_PROFILE_HOST
+#define SCREEN_WIDTH 160
+#define SCREEN_HEIGHT 128
+#define DISPLAY_DRIVER DISPLAY_DRIVER_HOSTFB
+#else
+#error "Unknown DISPLAY_PROFILE"
+#endif
+
+// Some ST7735 variants map the visible area at an offset inside controller RAM
+#ifndef DISPLAY_X_OFFSET
+#define DISPLAY_X_OFFSET 0
+#endif
+#ifndef DISPLAY_Y_OFFSET
+#define DISPLAY_Y_OFFSET 0
+#endif
+
+#endif
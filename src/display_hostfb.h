@@ -0,0 +1,50 @@
+#ifndef DISPLAY_HOSTFB_H
+#define DISPLAY_HOSTFB_H
+// Host framebuffer driver hooks.  Included by display.c only.
+// Pixels land in hostFramebuffer exactly as the ST7735 would receive them
+// (byte swapped RGB565 words from RGBToWord), following the same aperture
+// and auto-increment rules as the controller.
+
+uint16_t hostFramebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+static uint16_t apX1, apY1, apX2, apY2; // current aperture, inclusive
+static uint16_t curX, curY;             // next pixel to be written
+
+static void lcdBegin(void)
+{
+	apX1 = 0;
+	apY1 = 0;
+	apX2 = SCREEN_WIDTH - 1;
+	apY2 = SCREEN_HEIGHT - 1;
+	curX = 0;
+	curY = 0;
+}
+static void openAperture(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	apX1 = x1;
+	apY1 = y1;
+	apX2 = x2;
+	apY2 = y2;
+	curX = x1;
+	curY = y1;
+}
+static inline void lcdStartPixels(void)
+{
+}
+static inline void lcdWritePixel(uint16_t colour)
+{
+	// The panel silently drops writes outside its RAM, so do the same
+	if (curX < SCREEN_WIDTH && curY < SCREEN_HEIGHT)
+		hostFramebuffer[curY * SCREEN_WIDTH + curX] = colour;
+	if (curX == apX2)
+	{
+		curX = apX1;
+		curY = (curY == apY2) ? apY1 : (uint16_t)(curY + 1);
+	}
+	else
+	{
+		curX++;
+	}
+}
+
+#endif
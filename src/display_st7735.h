@@ -0,0 +1,241 @@
+#ifndef DISPLAY_ST7735_H
+#define DISPLAY_ST7735_H
+// ST7735 driver hooks over SPI1.  Included by display.c only, so every call
+// from the drawing routines is resolved (and usually inlined) at compile time.
+// Wiring: PA3 reset, PA4 CS, PA5 SCK, PA6 D/C, PA7 MOSI
+#include <stm32f031x6.h>
+#include "timebase.h"
+
+static void lcdBegin(void);
+static void openAperture(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+static inline void lcdStartPixels(void);
+static inline void lcdWritePixel(uint16_t colour);
+static void CSLow(void);
+static void CSHigh(void);
+static void DCLow(void);
+static void DCHigh(void);
+static void initSPI(void);
+static uint8_t transferSPI8(uint8_t data);
+static inline uint16_t transferSPI16(uint16_t data); // every pixel: inlined into the RAMFUNC loops
+static void command(uint8_t cmd);
+static void data(uint8_t data);
+static void ResetLow(void);
+static void ResetHigh(void);
+
+void lcdBegin()
+{
+	RCC->AHBENR |= (1 << 17);  // Turn on GPIO A
+	// Configure PA3 for Reset pin
+	GPIOA->MODER |= (1 << 6);
+	GPIOA->MODER &= ~(1u << 7);
+	// Configure PA4 for CS pin
+	GPIOA->MODER |= (1 << 8);
+	GPIOA->MODER &= ~(1u << 9);
+	// Configure PA6 for D/C pin
+	GPIOA->MODER |= (1 << 12);
+	GPIOA->MODER &= ~(1u << 13);
+	initSPI();
+	//  hw_test();
+	// Lots of CS toggling here seems to have made the boot up more reliable
+	CSHigh();
+	ResetHigh();	
+	delay(10);
+	ResetLow();
+	delay(200);
+	ResetHigh();
+	CSHigh();
+	delay(200);
+	CSLow();
+	delay(20);
+	command(0x01); // software reset
+	delay(100);
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0x11); // exit sleep
+	delay(120);
+	// set frame rate
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0xb1);
+	data(0x05);
+	data(0x3c);
+	data(0x3c);
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0xb2);
+	data(0x05);
+	data(0x3c);
+	data(0x3c);
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0xb3);
+	data(0x05);
+	data(0x3c);
+	data(0x3c);	
+	data(0x05);
+	data(0x3c);
+	data(0x3c);
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0xb4); // dot invert
+	data(0x03);
+	CSHigh();
+	delay(1);			
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0x36);// Set pixel and RGB order
+	data(DISPLAY_MADCTL); 	
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);		
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0x3a);// Set colour mode        
+	data(0x5); 	
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0x29);    // display on
+	delay(100);
+	CSHigh();
+	delay(1);
+	CSLow();
+	delay(1);
+	command(0x2c);   // put display in to write mode
+}
+void ResetLow()
+{
+	GPIOA->ODR &= ~(1u << 3);
+}
+void ResetHigh()
+{
+	GPIOA->ODR |= (1 << 3);
+}
+void CSLow()
+{
+	GPIOA->ODR &= ~(1u << 4);
+}
+void CSHigh()
+{
+	GPIOA->ODR |= (1 << 4);
+}
+void DCLow()
+{
+	GPIOA->ODR &= ~(1u << 6);
+}
+void DCHigh()
+{
+	GPIOA->ODR |= (1 << 6);
+}
+void initSPI(void)
+{
+	uint32_t  drain_count,drain;
+	
+	RCC->APB2ENR |= (1 << 12);		// turn on SPI1 	
+	
+	
+	// GPIOA bits 5 and 7 are used for SPI1 (Alternative functions 0)
+    GPIOA->MODER &= ~( (1u << 14)+(1u << 10)); // select Alternative function
+    GPIOA->MODER |= ((1 << 15)+(1 << 11));  // for bits 5,7 (not using MISO)
+    GPIOA->AFR[0] &= 0x000fffff;		     // select Alt. Function 0
+	
+	// Now configure the SPI interface	
+	drain = SPI1->SR;				// dummy read of SR to clear MODF	
+	// enable SSM, set SSI, enable SPI, PCLK/2, MSB First Master, Clock = 1 when idle
+	SPI1->CR1 = (1 << 9)+(1 << 8)+(1 << 6)+(1 << 2) +(1 << 1) + (1 << 0); // Might get away with removing bit 3 here and get 24MHz clock
+	SPI1->CR2 = (1 << 10)+(1 << 9)+(1 << 8); 	// configure for 8 bit operation
+   
+  for (drain_count = 0; drain_count < 32; drain_count++)
+	drain = transferSPI8((uint8_t)0x00);
+}
+
+uint8_t transferSPI8(uint8_t data)
+{
+    unsigned Timeout = 1000000;
+    uint8_t ReturnValue;
+    volatile uint8_t *preg=(volatile uint8_t*)&SPI1->DR;
+	
+    while (((SPI1->SR & (1 << 7))!=0)&&(Timeout--));
+    *preg = data;
+    Timeout = 1000000;
+    while (((SPI1->SR & (1 << 7))!=0)&&(Timeout--));        
+	  ReturnValue = *preg;	
+    return ReturnValue;
+}
+
+uint16_t transferSPI16(uint16_t data)
+{
+    unsigned Timeout = 1000000;
+    uint32_t ReturnValue;    
+	
+    while (((SPI1->SR & (1 << 7))!=0)&&(Timeout--));
+    SPI1->DR = data;
+    Timeout = 1000000;
+    while (((SPI1->SR & (1 << 7))!=0)&&(Timeout--));        
+	  ReturnValue = SPI1->DR;
+	
+    return (uint16_t)ReturnValue;
+}
+void command(uint8_t cmd)
+{
+	DCLow();
+	transferSPI8(cmd);
+}
+
+void data(uint8_t data)
+{
+	DCHigh();
+	transferSPI8(data);
+}
+
+
+void openAperture(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    // open up an area for drawing on the display    
+	x1 += DISPLAY_X_OFFSET;
+	x2 += DISPLAY_X_OFFSET;
+	y1 += DISPLAY_Y_OFFSET;
+	y2 += DISPLAY_Y_OFFSET;
+
+	command(0x2A); // Set X limits    	
+    data(x1>>8);
+    data(x1&0xff);        
+    data(x2>>8);
+    data(x2&0xff);
+    
+    command(0x2B);// Set Y limits
+    data(y1>>8);
+    data(y1&0xff);        
+    data(y2>>8);
+    data(y2&0xff);    
+        
+    command(0x2c); // put display in to data write mode
+	
+}
+// Switch the bus to pixel data after openAperture
+void lcdStartPixels(void)
+{
+	DCHigh();
+}
+void lcdWritePixel(uint16_t colour)
+{
+	transferSPI16(colour);
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include "effects.h"
+#include "display.h"
+#include "game.h"
+#include "arena.h"
+#include "governor.h"
+
+// Compute a rotated version of a square sprite directly from the original
+// rot: 0=0°, 1=90°CW, 2=180°, 3=270°CW
+void computeRotatedSprite(const uint16_t *src, uint16_t *dst, int size, int rot)
+{
+	for (int row = 0; row < size; row++)
+	{
+		for (int col = 0; col < size; col++)
+		{
+			int srcRow, srcCol;
+			switch (rot & 3)
+			{
+				case 0: srcRow = row; srcCol = col; break;
+				case 1: srcRow = size-1-col; srcCol = row; break;
+				case 2: srcRow = size-1-row; srcCol = size-1-col; break;
+				default: srcRow = col; srcCol = size-1-row; break;
+			}
+			dst[row * size + col] = src[srcRow * size + srcCol];
+		}
+	}
+}
+
+// Sin lookup table for 0-90 degrees, scaled by 256
+static const int16_t sinLUT[91] = {
+	0,4,9,13,18,22,27,31,36,40,44,49,53,58,62,66,71,75,79,83,
+	88,92,96,100,104,108,112,116,120,124,128,132,135,139,143,147,
+	150,154,158,161,164,168,171,175,178,181,184,187,190,193,196,199,
+	201,204,207,210,212,215,217,219,222,224,226,228,230,232,234,236,
+	237,239,241,242,243,245,246,247,248,249,250,252,252,253,254,254,
+	255,255,255,256,256,256,256
+};
+
+int fixSin(int deg)
+{
+	deg = ((deg % 360) + 360) % 360;
+	if (deg <= 90) return sinLUT[deg];
+	if (deg <= 180) return sinLUT[180 - deg];
+	if (deg <= 270) return -sinLUT[deg - 180];
+	return -sinLUT[360 - deg];
+}
+int fixCos(int deg) { return fixSin(deg + 90); }
+
+// Arbitrary-angle sprite rotation using nearest-neighbor sampling
+// Uses doubled coordinates to correctly center even-sized sprites
+void computeSmoothRotatedSprite(const uint16_t *src, uint16_t *dst, int srcSize, int angleDeg)
+{
+	int cs = fixCos(angleDeg);
+	int sn = fixSin(angleDeg);
+	int srcS1 = srcSize - 1;
+	int dstS1 = ROT_SIZE - 1;
+	for (int row = 0; row < ROT_SIZE; row++)
+	{
+		int dy2 = 2 * row - dstS1;
+		for (int col = 0; col < ROT_SIZE; col++)
+		{
+			int dx2 = 2 * col - dstS1;
+			int rx = dx2 * cs + dy2 * sn;
+			int ry = -dx2 * sn + dy2 * cs;
+			int srcCol = (rx + srcS1 * 256 + 256) / 512;
+			int srcRow = (ry + srcS1 * 256 + 256) / 512;
+			if (srcCol >= 0 && srcCol < srcSize && srcRow >= 0 && srcRow < srcSize)
+				dst[row * ROT_SIZE + col] = src[srcRow * srcSize + srcCol];
+			else
+				dst[row * ROT_SIZE + col] = 0;
+		}
+	}
+}
+
+// Draw a sprite buffer row-by-row, trimming zero-valued pixels at left/right edges.
+// This avoids drawing the black rotation corners while keeping interior black pixels.
+void drawSpriteNoCorners(uint16_t px, uint16_t py, int size, const uint16_t *sprite)
+{
+	for (int r = 0; r < size; r++)
+	{
+		const uint16_t *row = &sprite[r * size];
+		int left = -1, right = -1;
+		for (int c = 0; c < size; c++)
+		{
+			if (row[c] != 0)
+			{
+				if (left == -1) left = c;
+				right = c;
+			}
+		}
+		if (left >= 0)
+		{
+			int w = right - left + 1;
+			putImage((uint16_t)(px + left), (uint16_t)(py + r), (uint16_t)w, 1, &row[left], 0, 0);
+		}
+	}
+}
+
+// Particles live in the death/win overlay of the RAM arena
+int numParticles = 0;
+
+// Simple pseudo-random number generator
+static uint32_t rngState = 12345;
+void effectsSeed(uint32_t seed)
+{
+	rngState = seed;
+}
+uint32_t effectsRandState(void)
+{
+	return rngState;
+}
+uint32_t quickRand(void)
+{
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 17;
+	rngState ^= rngState << 5;
+	return rngState;
+}
+
+// Collect non-zero pixels from the current sprite and give them random velocities
+void scatterSprite(uint16_t spX, uint16_t spY)
+{
+	numParticles = 0;
+	for (int row = 0; row < ROT_SIZE && numParticles < MAX_PARTICLES; row++)
+	{
+		for (int col = 0; col < ROT_SIZE && numParticles < MAX_PARTICLES; col++)
+		{
+			uint16_t c = arena.mode.play.sprite[row * ROT_SIZE + col];
+			if (c != 0)
+			{
+				Particle *p = &arena.mode.effect.particles[numParticles++];
+				p->x = (int16_t)((spX - ROT_PAD + col) << 8);
+				p->y = (int16_t)((spY - ROT_PAD + row) << 8);
+				p->vx = (int16_t)((quickRand() % 512) - 256); // -256..255
+				p->vy = (int16_t)(-(int16_t)(quickRand() % 384) - 64); // mostly upward
+			}
+		}
+	}
+}
+
+// Advance the scatter particles by one animation frame
+void scatterFrame(void)
+{
+	const uint16_t *lit = arena.mode.play.sprite; // walked in step with the particles
+	for (int i = 0; i < numParticles; i++)
+	{
+		Particle *p = &arena.mode.effect.particles[i];
+		while (*lit == 0)
+			lit++;
+		uint16_t color = *lit++;
+		// Erase old position
+		int16_t sx = p->x >> 8;
+		int16_t sy = p->y >> 8;
+		if (sx >= 0 && sx < SCREEN_WIDTH && sy >= PLAYFIELD_TOP && sy < FLOOR_TOP)
+			putPixel((uint16_t)sx, (uint16_t)sy, 0);
+		// Update position
+		p->x += p->vx;
+		p->y += p->vy;
+		p->vy += 12; // gravity on particles
+		// Draw new position
+		sx = p->x >> 8;
+		sy = p->y >> 8;
+		if (sx >= 0 && sx < SCREEN_WIDTH && sy >= PLAYFIELD_TOP && sy < FLOOR_TOP)
+			putPixel((uint16_t)sx, (uint16_t)sy, color);
+	}
+}
+
+// =====================
+// Procedural portal system
+// =====================
+#define PORTAL_A  (PORTAL_WIDTH / 2)
+#define PORTAL_B  (PORTAL_HEIGHT / 2)
+#define PORTAL_A2 (PORTAL_A * PORTAL_A)
+#define PORTAL_B2 (PORTAL_B * PORTAL_B)
+#define PORTAL_A2B2 (PORTAL_A2 * PORTAL_B2)
+#define PORTAL_T1 (PORTAL_A2B2 / 4)
+#define PORTAL_T2 (PORTAL_A2B2 / 2)
+#define PORTAL_T3 (PORTAL_A2B2 * 3 / 4)
+
+static const uint16_t portalColors[4] = { 0xE607, 0xE02F, 0xF08F, 0x6005 };
+
+void drawProceduralPortal(int screenX, int portalY, int pulse)
+{
+	uint16_t *strip = arena.mode.play.portalRow;
+	for (int py = 0; py < PORTAL_HEIGHT; py++)
+	{
+		int dy = py - PORTAL_B;
+		int dy2a2 = dy * dy * PORTAL_A2;
+		if (dy2a2 > PORTAL_A2B2) continue;
+		// The visible part of a row is one run (the ellipse and the screen are
+		// both convex), so build it in the strip and send it in one go
+		int first = -1, count = 0;
+		for (int px = 0; px < PORTAL_WIDTH; px++)
+		{
+			int sx = screenX + px;
+			if (sx < 0 || sx >= SCREEN_WIDTH) continue;
+			int dx = px - PORTAL_A;
+			int val = dx * dx * PORTAL_B2 + dy2a2;
+			if (val <= PORTAL_A2B2)
+			{
+				int inner = PORTAL_A2B2 - val;
+				int ci;
+				if (inner < PORTAL_T1) ci = 0;
+				else if (inner < PORTAL_T2) ci = 1;
+				else if (inner < PORTAL_T3) ci = 2;
+				else ci = 3;
+				if (first < 0) first = sx;
+				strip[count++] = portalColors[(ci + pulse) & 3];
+			}
+		}
+		if (count > 0)
+			putImage((uint16_t)first, (uint16_t)(portalY + py), (uint16_t)count, 1, strip, 0, 0);
+	}
+}
+
+void spawnPortalParticle(int portalScreenX, int portalY)
+{
+	uint8_t limit = governorSparkLimit();
+	for (int i = 0; i < limit; i++)
+	{
+		PortalParticle *p = &arena.mode.play.portalParts[i];
+		if (p->life == 0)
+		{
+			int ry = (int)(quickRand() % PORTAL_HEIGHT);
+			int dy = ry - PORTAL_B;
+			int absdy = dy < 0 ? -dy : dy;
+			int hw = PORTAL_A * (PORTAL_B - absdy) / PORTAL_B;
+			if (hw < 1) hw = 1;
+			int cx = portalScreenX + PORTAL_A;
+			int side = (quickRand() & 1) ? 1 : -1;
+			p->x = (int16_t)((cx + side * hw) << 8);
+			p->y = (int16_t)((portalY + ry) << 8);
+			p->vx = (int16_t)(side * (int16_t)(quickRand() % 128 + 48));
+			p->vy = (int16_t)((int16_t)(quickRand() % 128) - 96);
+			p->life = (uint8_t)(PORTAL_PARTICLE_LIFE - (quickRand() % 10));
+			p->color = portalColors[quickRand() & 3];
+			break;
+		}
+	}
+}
+
+void updatePortalParticles(void)
+{
+	for (int i = 0; i < MAX_PORTAL_PARTICLES; i++)
+	{
+		PortalParticle *p = &arena.mode.play.portalParts[i];
+		if (p->life == 0) continue;
+		int16_t sx = p->x >> 8;
+		int16_t sy = p->y >> 8;
+		if (sx >= 0 && sx < SCREEN_WIDTH && sy >= PLAYFIELD_TOP && sy < FLOOR_TOP)
+			putPixel((uint16_t)sx, (uint16_t)sy, 0);
+		p->x += p->vx;
+		p->y += p->vy;
+		p->vy += 4;
+		p->life--;
+		if (p->life > 0) {
+			sx = p->x >> 8;
+			sy = p->y >> 8;
+			if (sx >= 0 && sx < SCREEN_WIDTH && sy >= PLAYFIELD_TOP && sy < FLOOR_TOP)
+				putPixel((uint16_t)sx, (uint16_t)sy, p->color);
+		}
+	}
+}
+
+void resetPortalParticles(void)
+{
+	for (int i = 0; i < MAX_PORTAL_PARTICLES; i++)
+		arena.mode.play.portalParts[i].life = 0;
+}
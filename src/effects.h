@@ -0,0 +1,55 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+#include <stdint.h>
+
+// Death particle presets
+#define MAX_PARTICLES 144
+#define SCATTER_FRAMES 40
+
+// Particle system for death explosion.  Particle i is the i-th lit pixel
+// of the player sprite, which keeps its colour for it.
+typedef struct {
+	int16_t x, y;       // current position (fixed point: *256)
+	int16_t vx, vy;     // velocity
+} Particle;
+
+// Exit portal sparks
+#define MAX_PORTAL_PARTICLES 32
+#define PORTAL_PARTICLE_LIFE 25
+
+typedef struct {
+	int16_t x, y;     // screen position << 8
+	int16_t vx, vy;
+	uint8_t life;
+	uint16_t color;
+} PortalParticle;
+
+// Sprite rotation.  computeRotatedSprite turns a square sprite by quarter
+// turns; computeSmoothRotatedSprite samples any angle into a ROT_SIZE
+// square (see game.h).  fixSin/fixCos are degrees in, scaled by 256 out.
+void computeRotatedSprite(const uint16_t *src, uint16_t *dst, int size, int rot);
+void computeSmoothRotatedSprite(const uint16_t *src, uint16_t *dst, int srcSize, int angleDeg);
+void drawSpriteNoCorners(uint16_t px, uint16_t py, int size, const uint16_t *sprite);
+int fixSin(int deg);
+int fixCos(int deg);
+
+// Effects randomness (xorshift, must not be seeded with zero).
+// effectsRandState is where the sequence has got to, to seed it back to.
+void effectsSeed(uint32_t seed);
+uint32_t effectsRandState(void);
+uint32_t quickRand(void);
+
+// Death burst: particles taken from the player sprite in the arena.  The
+// sprite mustn't change until the last scatterFrame.
+void scatterSprite(uint16_t spX, uint16_t spY);
+void scatterFrame(void);
+
+// Exit portal and its sparks.  The colour bands cycle through four
+// phases; PORTAL_PULSE gives the phase for a time in microseconds.
+#define PORTAL_PULSE(us) ((int)((us) / 150000u) & 3)
+void drawProceduralPortal(int screenX, int portalY, int pulse);
+void spawnPortalParticle(int portalScreenX, int portalY);
+void updatePortalParticles(void);
+void resetPortalParticles(void);
+
+#endif
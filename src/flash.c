@@ -0,0 +1,178 @@
+#include "flash.h"
+
+static int reserved(int page)
+{
+	return page >= FLASH_RESERVED_FIRST && page < FLASH_PAGES;
+}
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+
+#define FLASH_KEY_1 0x45670123u
+#define FLASH_KEY_2 0xcdef89abu
+
+static void unlock(void)
+{
+	if (FLASH->CR & (1 << 7))   // LOCK
+	{
+		FLASH->KEYR = FLASH_KEY_1;
+		FLASH->KEYR = FLASH_KEY_2;
+	}
+}
+// Wait for the operation to finish; 0 if it hit a programming or write
+// protection error
+static int finish(void)
+{
+	while (FLASH->SR & (1 << 0));   // BSY
+	uint32_t sr = FLASH->SR;
+	FLASH->SR = (1 << 5) | (1 << 4) | (1 << 2); // clear EOP, WRPRTERR and PGERR
+	return !(sr & ((1 << 4) | (1 << 2)));
+}
+
+int flashInit(void)
+{
+	return 1;
+}
+const uint8_t *flashPage(int page)
+{
+	return (const uint8_t *)(FLASH_ORIGIN + (uint32_t)page * FLASH_PAGE_BYTES);
+}
+int flashErasePage(int page)
+{
+	if (!reserved(page))
+		return 0;
+	unlock();
+	FLASH->CR |= (1 << 1);          // PER
+	FLASH->AR = FLASH_ORIGIN + (uint32_t)page * FLASH_PAGE_BYTES;
+	FLASH->CR |= (1 << 6);          // STRT
+	int ok = finish();
+	FLASH->CR &= ~(1u << 1);
+	FLASH->CR |= (1 << 7);          // lock again
+	const uint32_t *word = (const uint32_t *)flashPage(page);
+	for (int i = 0; i < FLASH_PAGE_BYTES / 4 && ok; i++)
+		ok = word[i] == 0xffffffffu;
+	return ok;
+}
+int flashProgram(int page, uint16_t offset, const uint8_t *data, uint16_t len)
+{
+	if (!reserved(page) || (offset & 1) || offset + len > FLASH_PAGE_BYTES)
+		return 0;
+	volatile uint16_t *dst = (volatile uint16_t *)flashPage(page) + offset / 2;
+	int ok = 1;
+	unlock();
+	FLASH->CR |= (1 << 0);          // PG
+	for (uint16_t i = 0; i < len && ok; i += 2)
+	{
+		uint16_t half = (uint16_t)(data[i] | ((i + 1 < len ? data[i + 1] : 0xff) << 8));
+		*dst = half;
+		ok = finish() && *dst == half;
+		dst++;
+	}
+	FLASH->CR &= ~(1u << 0);
+	FLASH->CR |= (1 << 7);          // lock again
+	return ok;
+}
+#else
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define FLASH_BYTES (FLASH_PAGES * FLASH_PAGE_BYTES)
+
+const char *hostFlashFile = "flash.bin";
+uint32_t hostFlashErases[FLASH_PAGES];
+int32_t hostFlashPowerCut = -1;
+
+static uint8_t *image;
+
+// 0 carries on, 1 cuts this operation short, 2 means the power is off
+static int powerCut(void)
+{
+	if (hostFlashPowerCut == -1)
+		return 0;
+	if (hostFlashPowerCut > 0)
+	{
+		hostFlashPowerCut--;
+		return 0;
+	}
+	if (hostFlashPowerCut == 0)
+	{
+		hostFlashPowerCut = -2;
+		return 1;
+	}
+	return 2;
+}
+
+int flashInit(void)
+{
+	int fd = open(hostFlashFile, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+	{
+		perror(hostFlashFile);
+		return 0;
+	}
+	int blank = lseek(fd, 0, SEEK_END) != FLASH_BYTES;
+	if (blank && ftruncate(fd, FLASH_BYTES) != 0)
+	{
+		perror(hostFlashFile);
+		close(fd);
+		return 0;
+	}
+	void *map = mmap(0, FLASH_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		perror(hostFlashFile);
+		return 0;
+	}
+	image = map;
+	// A file of any other size is a new chip
+	if (blank)
+		memset(image, 0xff, FLASH_BYTES);
+	memset(hostFlashErases, 0, sizeof(hostFlashErases));
+	return 1;
+}
+const uint8_t *flashPage(int page)
+{
+	return image + (uint32_t)page * FLASH_PAGE_BYTES;
+}
+int flashErasePage(int page)
+{
+	if (!reserved(page))
+		return 0;
+	int cut = powerCut();
+	if (cut == 2)
+		return 0;
+	// Cut short, only the first half gets erased
+	memset(image + (uint32_t)page * FLASH_PAGE_BYTES, 0xff, cut ? FLASH_PAGE_BYTES / 2 : FLASH_PAGE_BYTES);
+	hostFlashErases[page]++;
+	return !cut;
+}
+int flashProgram(int page, uint16_t offset, const uint8_t *data, uint16_t len)
+{
+	if (!reserved(page) || (offset & 1) || offset + len > FLASH_PAGE_BYTES)
+		return 0;
+	uint8_t *dst = image + (uint32_t)page * FLASH_PAGE_BYTES + offset;
+	for (uint16_t i = 0; i < len; i += 2, dst += 2)
+	{
+		uint16_t half = (uint16_t)(data[i] | ((i + 1 < len ? data[i + 1] : 0xff) << 8));
+		uint16_t old = (uint16_t)(dst[0] | (dst[1] << 8));
+		int cut = powerCut();
+		// The F031 refuses (PGERR) to program a halfword that isn't erased,
+		// except with zero
+		if (cut == 2 || (old != 0xffff && half != 0))
+			return 0;
+		// Cut short, only some of the bits get cleared
+		if (cut)
+			half |= 0x5555;
+		half &= old;
+		dst[0] = (uint8_t)half;
+		dst[1] = (uint8_t)(half >> 8);
+		if (cut)
+			return 0;
+	}
+	return 1;
+}
+#endif
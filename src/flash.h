@@ -0,0 +1,60 @@
+#ifndef FLASH_H
+#define FLASH_H
+#include <stdint.h>
+
+// ============================================
+// FLASH PAGES
+// The F031K6 has 32 pages of 1 KB.  The image keeps out of the top ones,
+// which hold data written at run time; only those can be erased or
+// programmed through here.  Flash erases to all ones and is programmed a
+// halfword at a time, and a halfword can't be reprogrammed until its page
+// is erased again.  The core stalls while flash is busy (about 40 us a
+// halfword, up to 40 ms an erase), so none of this is for frame time.
+//
+// Reserved pages, from the top:
+//   FLASH_KV_PAGES     key-value store (kv.h)
+//   FLASH_LEVEL_PAGES  uploaded level (upload.h)
+// custom_flash_budget in platformio.ini (and FLASH in the speed build's
+// linker script) keeps the image below them.
+//
+// Host builds keep the whole flash in a file (hostFlashFile), mapped, so
+// what's written survives from one run to the next.
+// ============================================
+#define FLASH_ORIGIN 0x08000000u
+#define FLASH_PAGE_BYTES 1024
+#define FLASH_PAGES 32
+
+#define FLASH_KV_PAGES 2
+#define FLASH_KV_FIRST (FLASH_PAGES - FLASH_KV_PAGES)
+#define FLASH_LEVEL_PAGES 1
+#define FLASH_LEVEL_FIRST (FLASH_KV_FIRST - FLASH_LEVEL_PAGES)
+// Lowest page that may be written
+#define FLASH_RESERVED_FIRST FLASH_LEVEL_FIRST
+
+// Worst case F031 flash timings (datasheet tERASE and tPROG), for callers
+// that budget their flash work
+#define FLASH_ERASE_US 40000
+#define FLASH_PROGRAM_US 60 // a halfword
+
+// Returns 0 if the host file can't be opened (said why on stderr)
+int flashInit(void);
+// Start of a page, readable directly
+const uint8_t *flashPage(int page);
+// Each returns 0 if the page isn't a reserved one or the result doesn't
+// read back as asked.  flashProgram writes len bytes (an odd last byte is
+// padded with 0xff) at an even offset into the page.
+int flashErasePage(int page);
+int flashProgram(int page, uint16_t offset, const uint8_t *data, uint16_t len);
+
+#ifdef HOST_BUILD
+// Backing file, created erased if it doesn't exist
+extern const char *hostFlashFile;
+// Erases per page since flashInit
+extern uint32_t hostFlashErases[FLASH_PAGES];
+// Simulated power cut: when this many more halfwords have been programmed
+// or pages erased, the next one is left half done and nothing after it
+// happens until this is set back to -1 (never)
+extern int32_t hostFlashPowerCut;
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+#include <string.h>
+#include "game.h"
+#include "profiler.h"
+
+void gameReset(GameState *g, const LevelInfo *level)
+{
+	g->level = level;
+	g->scrollOffset = SCROLL_START;
+	g->jumpHeight = 0.0;
+	g->currentVelocity = 0.0;
+	g->drawY = GROUND_Y;
+	g->isInAir = 0;
+	g->dead = 0;
+	g->won = 0;
+	g->rotation = 0;
+	g->rotAngle = 0;
+	g->targetRotAngle = 0;
+	g->tick = 0;
+}
+
+// Level column containing world x (rounds towards minus infinity)
+static int columnAt(int worldX)
+{
+	if (worldX >= 0)
+		return worldX / OBSTACLE_SIZE;
+	return -((-worldX + OBSTACLE_SIZE - 1) / OBSTACLE_SIZE);
+}
+// Screen x of a level column's left edge
+static int columnScreenX(int col, int scrollInt)
+{
+	return col * OBSTACLE_SIZE - scrollInt;
+}
+static int overlapsPlayerX(int screenX)
+{
+	return screenX < (PLAYER_X + MAIN_CHARACTER_SPRITE_SIZE_X) && screenX + OBSTACLE_SIZE > PLAYER_X;
+}
+static uint8_t tileAt(const LevelInfo *level, int row, int col)
+{
+	if (col < 0 || col >= level->length) return TILE_EMPTY;
+	return level->rows[row][col];
+}
+
+// Only the columns either side of the player can touch it
+static int firstPlayerColumn(int scrollInt)
+{
+	return columnAt(scrollInt + PLAYER_X) - 1;
+}
+
+int gameSupportRow(const GameState *g, int charBottom, int slack)
+{
+	int scrollInt = (int)g->scrollOffset;
+	int firstCol = firstPlayerColumn(scrollInt);
+	for (int row = 0; row < ROWS_VISIBLE; row++)
+	{
+		int rowY = FLOOR_TOP - (row + 1) * OBSTACLE_SIZE;
+		if (charBottom < rowY || charBottom > rowY + slack) continue;
+		for (int col = firstCol; col <= firstCol + 2; col++)
+		{
+			if (tileAt(g->level, row, col) == TILE_BLOCK && overlapsPlayerX(columnScreenX(col, scrollInt)))
+				return row;
+		}
+	}
+	return -1;
+}
+
+int gameHazards(GameState *g)
+{
+	int events = 0;
+	int scrollInt = (int)g->scrollOffset;
+	int firstCol = firstPlayerColumn(scrollInt);
+	int drawY = g->drawY;
+	for (int row = 0; row < ROWS_VISIBLE; row++)
+	{
+		int rowY = FLOOR_TOP - (row + 1) * OBSTACLE_SIZE;
+		if (drawY >= rowY + OBSTACLE_SIZE || drawY + MAIN_CHARACTER_SPRITE_SIZE_Y <= rowY) continue;
+		for (int col = firstCol; col <= firstCol + 2; col++)
+		{
+			uint8_t tile = tileAt(g->level, row, col);
+			if (tile == TILE_EMPTY || !overlapsPlayerX(columnScreenX(col, scrollInt))) continue;
+			if (tile == TILE_SPIKE)
+			{
+				// Spike hitbox — shrink top by 6px so only the actual triangle kills
+				if (drawY + MAIN_CHARACTER_SPRITE_SIZE_Y > rowY + 6)
+					g->dead = 1;
+			}
+			else if (tile == TILE_BLOCK)
+			{
+				// Side/embedded collision — kill unless player is standing on top
+				// If feet are more than 4px into the block, it's a side hit — die
+				// If feet are only 0-4px in, the landing physics should handle it
+				if (drawY + MAIN_CHARACTER_SPRITE_SIZE_Y > rowY + 4)
+					g->dead = 1;
+			}
+			else if (tile == TILE_PAD)
+			{
+				// Jump pad collision — force a super jump
+				g->isInAir = 1;
+				g->currentVelocity = JUMP_PAD_JUMP_POWER;
+				g->rotation++;
+				g->targetRotAngle = g->rotation * 90;
+				events |= GAME_EVENT_PAD;
+			}
+		}
+	}
+	return events;
+}
+
+int gameStep(GameState *g, int jump)
+{
+	int events = 0;
+
+	// Jump physics
+	if (jump && g->isInAir == 0)
+	{
+		g->isInAir = 1;
+		g->currentVelocity = JUMP_POWER;
+		g->rotation++;
+		g->targetRotAngle = g->rotation * 90;
+		events |= GAME_EVENT_JUMP;
+	}
+
+	if (g->isInAir)
+	{
+		g->currentVelocity -= GRAVITY * GAME_TICK_MS;
+		g->jumpHeight += g->currentVelocity * GAME_TICK_MS;
+
+		// Check if landing on a platform block
+		int landed = 0;
+		PROFILE_BEGIN(PROF_COLLISION);
+		if (g->currentVelocity <= 0)
+		{
+			int charBottom = GROUND_Y - (int)g->jumpHeight + MAIN_CHARACTER_SPRITE_SIZE_Y;
+			int row = gameSupportRow(g, charBottom, OBSTACLE_SIZE);
+			if (row >= 0)
+			{
+				int rowY = FLOOR_TOP - (row + 1) * OBSTACLE_SIZE;
+				g->jumpHeight = (double)(GROUND_Y - rowY + MAIN_CHARACTER_SPRITE_SIZE_Y);
+				g->currentVelocity = 0.0;
+				g->isInAir = 0;
+				g->rotAngle = g->targetRotAngle;
+				landed = 1;
+			}
+		}
+		PROFILE_END(PROF_COLLISION);
+
+		if (!landed && g->jumpHeight <= 0.0)
+		{
+			g->jumpHeight = 0.0;
+			g->currentVelocity = 0.0;
+			g->isInAir = 0;
+			g->rotAngle = g->targetRotAngle;
+		}
+	}
+	else if (g->jumpHeight > 0.0)
+	{
+		// Not in air — check if still standing on a platform
+		PROFILE_BEGIN(PROF_COLLISION);
+		int charBottom = GROUND_Y - (int)g->jumpHeight + MAIN_CHARACTER_SPRITE_SIZE_Y;
+		if (gameSupportRow(g, charBottom, 2) < 0)
+		{
+			g->isInAir = 1;
+			g->currentVelocity = 0.0;
+		}
+		PROFILE_END(PROF_COLLISION);
+	}
+
+	g->drawY = (uint16_t)(GROUND_Y - (int)g->jumpHeight);
+
+	// Scroll the level
+	g->scrollOffset += (float)SCROLL_SPEED;
+
+	// Hazards at the new position
+	PROFILE_BEGIN(PROF_COLLISION);
+	events |= gameHazards(g);
+	PROFILE_END(PROF_COLLISION);
+	g->tick++;
+	if (g->dead)
+		return events;
+
+	// Smooth rotation while airborne
+	if (g->isInAir && g->rotAngle != g->targetRotAngle)
+	{
+		int diff = g->targetRotAngle - g->rotAngle;
+		int sign = (diff > 0) ? 1 : -1;
+		int step = sign * 6;  // 6 degrees per tick — smooth constant speed
+		if (sign * diff < 6) step = diff; // snap if close enough
+		g->rotAngle += step;
+	}
+
+	// Reaching the exit portal wins the level
+	if (gamePortalScreenX(g) <= SCREEN_WIDTH - PORTAL_WIDTH)
+		g->won = 1;
+	return events;
+}
+
+int gamePortalScreenX(const GameState *g)
+{
+	return g->level->length * OBSTACLE_SIZE - (int)g->scrollOffset;
+}
+
+int gameProgress(const GameState *g, int scale)
+{
+	// The run is won once the portal is fully on screen
+	float span = (float)(g->level->length * OBSTACLE_SIZE - (SCREEN_WIDTH - PORTAL_WIDTH)) - SCROLL_START;
+	float done = g->scrollOffset - SCROLL_START;
+	if (g->won || done >= span)
+		return scale;
+	if (done <= 0)
+		return 0;
+	return (int)(done * (float)scale / span);
+}
+
+static uint32_t hashBytes(uint32_t h, const void *data, unsigned len)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	while (len--)
+	{
+		h ^= *p++;
+		h *= 16777619u; // FNV-1a
+	}
+	return h;
+}
+uint32_t gameHash(const GameState *g)
+{
+	// Field by field so struct padding never leaks in
+	uint32_t h = 2166136261u;
+	h = hashBytes(h, &g->scrollOffset, sizeof(g->scrollOffset));
+	h = hashBytes(h, &g->jumpHeight, sizeof(g->jumpHeight));
+	h = hashBytes(h, &g->currentVelocity, sizeof(g->currentVelocity));
+	h = hashBytes(h, &g->drawY, sizeof(g->drawY));
+	h = hashBytes(h, &g->isInAir, 1);
+	h = hashBytes(h, &g->dead, 1);
+	h = hashBytes(h, &g->won, 1);
+	h = hashBytes(h, &g->rotation, sizeof(g->rotation));
+	h = hashBytes(h, &g->rotAngle, sizeof(g->rotAngle));
+	h = hashBytes(h, &g->targetRotAngle, sizeof(g->targetRotAngle));
+	h = hashBytes(h, &g->tick, sizeof(g->tick));
+	return h;
+}
@@ -0,0 +1,94 @@
+#ifndef GAME_H
+#define GAME_H
+#include <stdint.h>
+#include "display_config.h"
+#include "levels.h"
+
+// Sizing data
+#define MAIN_CHARACTER_SPRITE_SIZE_X 16
+#define MAIN_CHARACTER_SPRITE_SIZE_Y 16
+#define ROT_SIZE 20
+#define ROT_PAD ((ROT_SIZE - MAIN_CHARACTER_SPRITE_SIZE_X) / 2)
+#define FLOOR_LEVEL_Y 17
+
+// Physics settings
+#define JUMP_POWER 0.26f
+#define GRAVITY 0.001f
+#define JUMP_PAD_JUMP_POWER 0.35f
+
+// The simulation runs in fixed ticks so an attempt plays out identically
+// whatever the frame rate (and can be replayed).  Physics constants are per
+// millisecond; SCROLL_SPEED is pixels per tick.  30 ms is about what a frame
+// took when physics ran on wall-clock time, and the levels are built for it.
+#ifndef GAME_TICK_US
+#define GAME_TICK_US 30000u
+#endif
+#define GAME_TICK_MS ((double)GAME_TICK_US / 1000.0)
+// A frame that overruns catches up at most this many ticks
+#define GAME_MAX_CATCHUP_TICKS 4
+
+// General game data
+#define OBSTACLE_SIZE 16
+#define SCROLL_SPEED 2.8f
+
+// Playfield layout, derived from the display profile in display_config.h
+#define FLOOR_TOP (SCREEN_HEIGHT - FLOOR_LEVEL_Y)               // first row of the floor band
+#define HUD_HEIGHT 9                                            // status strip across the top (hud.h)
+#define PLAYFIELD_TOP HUD_HEIGHT                                // first row the playfield draws on
+#define FLOOR_COLOUR (5466766u & 0xFFFF)
+#define SCREEN_CENTER_X (SCREEN_WIDTH / 2)
+#define TILES_ACROSS (SCREEN_WIDTH / OBSTACLE_SIZE + 1)         // columns touched by one frame (one is partial)
+#define PLAYER_X ((SCREEN_WIDTH * 3) / 8)                       // 60 on the 160 wide panel
+#define GROUND_Y (FLOOR_TOP - MAIN_CHARACTER_SPRITE_SIZE_Y)     // player top when standing on the floor
+#define SCROLL_START (-(float)(PLAYER_X + MAIN_CHARACTER_SPRITE_SIZE_X)) // level column 0 starts at the player's right edge
+
+// Rows that fit between the HUD and the floor on this display
+#if LEVEL_ROWS * OBSTACLE_SIZE < FLOOR_TOP - PLAYFIELD_TOP
+#define ROWS_VISIBLE LEVEL_ROWS
+#else
+#define ROWS_VISIBLE ((FLOOR_TOP - PLAYFIELD_TOP) / OBSTACLE_SIZE)
+#endif
+
+// Exit portal
+#define PORTAL_WIDTH 20
+#define PORTAL_HEIGHT ((FLOOR_TOP - PLAYFIELD_TOP) & ~1)        // even, so the ellipse centre is a whole pixel
+
+// Everything the simulation needs to carry from one tick to the next.
+// Rendering only reads it.
+typedef struct {
+	const LevelInfo *level;
+	float scrollOffset;      // world x at the left edge of the screen
+	double jumpHeight;       // pixels above the floor
+	double currentVelocity;  // pixels per millisecond
+	uint16_t drawY;          // player top on screen
+	uint8_t isInAir;
+	uint8_t dead;
+	uint8_t won;
+	int rotation;            // quarter turns started so far
+	int rotAngle;            // current smooth angle in degrees
+	int targetRotAngle;      // target angle to interpolate toward
+	uint32_t tick;
+} GameState;
+
+// gameStep return flags
+#define GAME_EVENT_JUMP 0x01  // a jump started from the ground this tick
+#define GAME_EVENT_PAD 0x02   // a jump pad fired
+
+void gameReset(GameState *g, const LevelInfo *level);
+// Advance one tick.  jump: is a jump button (or buffered press) active
+int gameStep(GameState *g, int jump);
+// The collision scans gameStep is built from.  gameSupportRow: lowest
+// level row with a block the player is standing on, its feet (charBottom)
+// no more than slack pixels below the block's top; -1 if none.
+// gameHazards: spikes, block sides and pads at the current position; sets
+// dead or starts a pad jump, returns GAME_EVENT_PAD if one fired.
+int gameSupportRow(const GameState *g, int charBottom, int slack);
+int gameHazards(GameState *g);
+// Position of the exit portal's left edge on screen
+int gamePortalScreenX(const GameState *g);
+// How far through the level the run is, 0 at the start to scale on winning
+int gameProgress(const GameState *g, int scale);
+// Fingerprint of the simulation state, identical on the device and the host
+uint32_t gameHash(const GameState *g);
+
+#endif
@@ -0,0 +1,70 @@
+#include "governor.h"
+#include "effects.h"
+
+static uint8_t level;
+static int8_t forced = -1;
+static uint8_t overCount, underCount;
+static uint8_t frameCount;
+
+void governorReset(void)
+{
+	level = (forced >= 0) ? (uint8_t)forced : QUALITY_FULL;
+	overCount = 0;
+	underCount = 0;
+	frameCount = 0;
+}
+void governorFrame(uint32_t workUs)
+{
+	frameCount++;
+	if (forced >= 0)
+		return;
+	if (workUs > GOVERNOR_BUDGET_US)
+	{
+		underCount = 0;
+		if (++overCount >= GOVERNOR_DOWN_FRAMES)
+		{
+			overCount = 0;
+			if (level < QUALITY_LEVELS - 1) level++;
+		}
+	}
+	else if (workUs < GOVERNOR_RECOVER_US)
+	{
+		overCount = 0;
+		if (++underCount >= GOVERNOR_UP_FRAMES)
+		{
+			underCount = 0;
+			if (level > QUALITY_FULL) level--;
+		}
+	}
+	else
+	{
+		// Between the thresholds: hold
+		overCount = 0;
+		underCount = 0;
+	}
+}
+uint8_t governorLevel(void)
+{
+	return level;
+}
+void governorForce(int newLevel)
+{
+	forced = (int8_t)((newLevel >= 0 && newLevel < QUALITY_LEVELS) ? newLevel : -1);
+	governorReset();
+}
+uint8_t governorSparkLimit(void)
+{
+	return (level >= QUALITY_FEWER_SPARKS) ? MAX_PORTAL_PARTICLES / 2 : MAX_PORTAL_PARTICLES;
+}
+int governorPortalDue(void)
+{
+	return (level < QUALITY_SLOW_PORTAL) || (frameCount & 1) == 0;
+}
+int governorHudDue(void)
+{
+	return (level < QUALITY_LAZY_HUD) || (frameCount & 3) == 0;
+}
+int governorRotationStep(void)
+{
+	return (level >= QUALITY_COARSE_ROTATION) ? 18 : 6;
+}
@@ -0,0 +1,52 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+#include <stdint.h>
+#include "game.h"
+
+// ============================================
+// QUALITY GOVERNOR
+// The simulation runs on fixed ticks whatever happens (see game.h), so a
+// slow frame doesn't change the physics, but it does make the picture
+// skip ticks and the jump look late.  The governor watches how long each
+// frame's work took and trades looks for time when frames run over:
+//
+//   QUALITY_FULL             everything
+//   QUALITY_FEWER_SPARKS     half the portal sparks
+//   QUALITY_SLOW_PORTAL      portal redrawn (and pulsing) every other frame
+//   QUALITY_LAZY_HUD         HUD bar and overlay redrawn every 4th frame
+//   QUALITY_COARSE_ROTATION  player sprite re-rotated every 18 degrees, not 6
+//
+// Each level includes the ones above it.  It steps down one level after
+// GOVERNOR_DOWN_FRAMES frames in a row over GOVERNOR_BUDGET_US, and back up
+// one after GOVERNOR_UP_FRAMES in a row under GOVERNOR_RECOVER_US.  The gap
+// between the two thresholds (and the long climb back) stops it hunting
+// between levels when a frame sits near the budget.
+// ============================================
+enum {
+	QUALITY_FULL,
+	QUALITY_FEWER_SPARKS,
+	QUALITY_SLOW_PORTAL,
+	QUALITY_LAZY_HUD,
+	QUALITY_COARSE_ROTATION,
+	QUALITY_LEVELS
+};
+
+#define GOVERNOR_BUDGET_US (GAME_TICK_US * 7 / 8)   // leave some of the tick for pacing jitter
+#define GOVERNOR_RECOVER_US (GAME_TICK_US * 5 / 8)
+#define GOVERNOR_DOWN_FRAMES 3
+#define GOVERNOR_UP_FRAMES 60
+
+void governorReset(void);
+// Report the rendering work of the frame just finished
+void governorFrame(uint32_t workUs);
+uint8_t governorLevel(void);
+// Pin a level (for testing how a level looks), or -1 to go back to automatic
+void governorForce(int level);
+
+// What the current level allows this frame
+uint8_t governorSparkLimit(void);
+int governorPortalDue(void);
+int governorHudDue(void);
+int governorRotationStep(void);
+
+#endif
@@ -0,0 +1,239 @@
+// Host kernel benchmark.  Times the drawing and physics kernels one at a
+// time over many iterations, drawing into the host framebuffer driver
+// (display_hostfb.h) in place of the SPI bus, so a change that slows a
+// kernel down shows up before anything is flashed.
+//
+//   bench [-t ms] [-o file] [-c baseline] [-r percent]
+//
+// Prints one line per kernel, whitespace separated:
+//
+//   <kernel> <iterations> <ns_per_op>
+//
+// -o writes the same lines to a file, to keep as a baseline.  -c reads a
+// baseline back and adds its ns_per_op and the change in percent to each
+// line, marking kernels more than -r percent (default 15) slower with
+// REGRESSED; the exit status is then 1.  -t is the time each of the five
+// timed runs per kernel aims for (default 20); the best run is reported.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "display.h"
+#include "arena.h"
+#include "effects.h"
+#include "game.h"
+#include "levels.h"
+#include "timebase.h"
+#include "sprite_map.h"
+
+#define BENCH_RUNS 5
+#define MAX_STATES 4096
+#define MAX_KERNELS 32
+
+static volatile int sink; // results land here so the work isn't optimised away
+
+static double seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Player positions sampled along every level at a few heights, for the
+// collision scans
+static GameState states[MAX_STATES];
+static int numStates;
+
+static void buildStates(void)
+{
+	static const int heights[] = { 0, 8, 16, 24, 32, 48 };
+	int lvl = 0;
+	while (numStates < MAX_STATES)
+	{
+		for (float s = SCROLL_START; s < levels[lvl].length * OBSTACLE_SIZE && numStates < MAX_STATES; s += SCROLL_SPEED)
+		{
+			for (unsigned h = 0; h < sizeof(heights) / sizeof(heights[0]) && numStates < MAX_STATES; h++)
+			{
+				GameState *g = &states[numStates++];
+				gameReset(g, &levels[lvl]);
+				g->scrollOffset = s;
+				g->jumpHeight = heights[h];
+				g->drawY = (uint16_t)(GROUND_Y - heights[h]);
+			}
+		}
+		lvl = (lvl + 1) % NUM_LEVELS;
+	}
+}
+
+static void kPutImage00(uint32_t i) { putImage((uint16_t)(i % 144), 40, 16, 16, mainChar, 0, 0); }
+static void kPutImage10(uint32_t i) { putImage((uint16_t)(i % 144), 40, 16, 16, mainChar, 1, 0); }
+static void kPutImage01(uint32_t i) { putImage((uint16_t)(i % 144), 40, 16, 16, mainChar, 0, 1); }
+static void kPutImage11(uint32_t i) { putImage((uint16_t)(i % 144), 40, 16, 16, mainChar, 1, 1); }
+static void kRotate(uint32_t i)
+{
+	computeSmoothRotatedSprite(mainChar, arena.mode.play.sprite, MAIN_CHARACTER_SPRITE_SIZE_X, (int)(i % 360));
+}
+static void kPortal(uint32_t i)
+{
+	drawProceduralPortal((int)(i % SCREEN_WIDTH) - PORTAL_WIDTH / 2, FLOOR_TOP - PORTAL_HEIGHT, (int)(i & 3));
+}
+static void kPrintText(uint32_t i)
+{
+	printText("0123456789ABCDEF", 2, (uint16_t)((i % 12) * 10), 0xffff, 0);
+}
+static void kSupport(uint32_t i)
+{
+	const GameState *g = &states[i % numStates];
+	sink += gameSupportRow(g, GROUND_Y - (int)g->jumpHeight + MAIN_CHARACTER_SPRITE_SIZE_Y, OBSTACLE_SIZE);
+}
+static void kHazards(uint32_t i)
+{
+	GameState g = states[i % numStates];
+	sink += gameHazards(&g) + g.dead;
+}
+static void kFixSin(uint32_t i)
+{
+	sink += fixSin((int)(i % 720) - 360);
+}
+
+typedef struct {
+	const char *name;
+	void (*run)(uint32_t i);
+} Kernel;
+
+static const Kernel kernels[] = {
+	{ "putImage_h0v0", kPutImage00 },
+	{ "putImage_h1v0", kPutImage10 },
+	{ "putImage_h0v1", kPutImage01 },
+	{ "putImage_h1v1", kPutImage11 },
+	{ "computeSmoothRotatedSprite", kRotate },
+	{ "drawProceduralPortal", kPortal },
+	{ "printText16", kPrintText },
+	{ "gameSupportRow", kSupport },
+	{ "gameHazards", kHazards },
+	{ "fixSin", kFixSin },
+};
+#define NUM_KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+// Best of BENCH_RUNS, each long enough to swamp the clock reads
+static double timeKernel(const Kernel *k, double target, uint32_t *iterations)
+{
+	uint32_t n = 1;
+	for (;;)
+	{
+		double t0 = seconds();
+		for (uint32_t i = 0; i < n; i++) k->run(i);
+		if (seconds() - t0 >= target / 4 || n >= (1u << 30)) break;
+		n *= 2;
+	}
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		double t0 = seconds();
+		for (uint32_t i = 0; i < n; i++) k->run(i);
+		double ns = (seconds() - t0) * 1e9 / n;
+		if (run == 0 || ns < best) best = ns;
+	}
+	*iterations = n;
+	return best;
+}
+
+typedef struct {
+	char name[64];
+	double ns;
+} BaselineEntry;
+
+static int readBaseline(const char *path, BaselineEntry *out, int max)
+{
+	FILE *f = fopen(path, "r");
+	if (!f)
+	{
+		perror(path);
+		return -1;
+	}
+	char line[160];
+	int count = 0;
+	while (count < max && fgets(line, sizeof(line), f))
+	{
+		unsigned long iterations;
+		if (line[0] == '#') continue;
+		if (sscanf(line, "%63s %lu %lf", out[count].name, &iterations, &out[count].ns) == 3)
+			count++;
+	}
+	fclose(f);
+	return count;
+}
+
+int main(int argc, char **argv)
+{
+	double target = 0.020;
+	double tolerance = 15.0;
+	const char *outPath = NULL;
+	const char *basePath = NULL;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			target = atof(argv[++i]) / 1000.0;
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			outPath = argv[++i];
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+			basePath = argv[++i];
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			tolerance = atof(argv[++i]);
+		else
+		{
+			fprintf(stderr, "usage: %s [-t ms] [-o file] [-c baseline] [-r percent]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	BaselineEntry baseline[MAX_KERNELS];
+	int baseCount = 0;
+	if (basePath && (baseCount = readBaseline(basePath, baseline, MAX_KERNELS)) < 0)
+		return 2;
+	FILE *out = NULL;
+	if (outPath && (out = fopen(outPath, "w")) == NULL)
+	{
+		perror(outPath);
+		return 2;
+	}
+
+	timebaseInit();
+	display_begin();
+	arenaEnter(ARENA_PLAY);
+	effectsSeed(12345);
+	buildStates();
+
+	int regressions = 0;
+	printf(basePath ? "# kernel iterations ns_per_op baseline_ns change_pct\n" : "# kernel iterations ns_per_op\n");
+	if (out) fprintf(out, "# kernel iterations ns_per_op\n");
+	for (int k = 0; k < NUM_KERNELS; k++)
+	{
+		uint32_t iterations;
+		double ns = timeKernel(&kernels[k], target, &iterations);
+		printf("%s %lu %.2f", kernels[k].name, (unsigned long)iterations, ns);
+		if (out) fprintf(out, "%s %lu %.2f\n", kernels[k].name, (unsigned long)iterations, ns);
+		if (basePath)
+		{
+			int b = 0;
+			while (b < baseCount && strcmp(baseline[b].name, kernels[k].name) != 0) b++;
+			if (b == baseCount || baseline[b].ns <= 0)
+			{
+				printf(" - - NEW");
+			}
+			else
+			{
+				double change = (ns / baseline[b].ns - 1.0) * 100.0;
+				printf(" %.2f %+.1f", baseline[b].ns, change);
+				if (change > tolerance)
+				{
+					printf(" REGRESSED");
+					regressions++;
+				}
+			}
+		}
+		printf("\n");
+	}
+	if (out) fclose(out);
+	return regressions ? 1 : 0;
+}
@@ -0,0 +1,312 @@
+// Golden-frame check.  Plays recorded runs through the real gameplay
+// renderer (render.c and everything under it, and the HUD) into the host
+// framebuffer, hashes the framebuffer at chosen frames, and compares the
+// hashes with the ones stored alongside each recording.  A renderer change that is
+// meant to be invisible has to keep every hash.
+//
+//   golden [-u] [-e frames] [-d dir] [file]
+//
+// The file (default src/host/golden_frames.txt) holds REPLAY lines, as
+// printed over serial when a level is won, each followed by the frames
+// to check:
+//
+//   FRAME <frame> <hash>
+//
+// One frame is one simulation tick here, i.e. a device running on time.
+// -u rewrites the FRAME lines from the current renderer, every -e frames
+// (default 30), each frame with the player clipped at the top of the
+// playfield, and the last one.  With -d, every mismatching frame is
+// saved there as L<level>_F<frame>.ppm; -u -d also saves each golden
+// frame as L<level>_F<frame>_golden.ppm, and when a golden image is
+// there a check writes L<level>_F<frame>_diff.ppm (changed pixels red over
+// the golden frame dimmed).  Exit status is 1 if any hash differs.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "display.h"
+#include "arena.h"
+#include "effects.h"
+#include "game.h"
+#include "governor.h"
+#include "hud.h"
+#include "levels.h"
+#include "render.h"
+#include "replay.h"
+#include "sprite_map.h"
+#include "timebase.h"
+
+#define MAX_RUNS 16
+#define MAX_CHECKS 256
+
+typedef struct {
+	char replayLine[512];
+	Replay replay;
+	int checks;
+	uint32_t frame[MAX_CHECKS];
+	uint32_t hash[MAX_CHECKS];
+} Run;
+
+static Run runs[MAX_RUNS];
+static int numRuns;
+static const char *ppmDir;
+
+static uint32_t frameHash(void)
+{
+	uint32_t h = 2166136261u;
+	const uint8_t *p = (const uint8_t *)hostFramebuffer;
+	for (unsigned i = 0; i < sizeof(hostFramebuffer); i++)
+	{
+		h ^= p[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+// hostFramebuffer holds the byte swapped RGB565 words the panel is sent
+static void pixelRGB(uint16_t word, uint8_t *rgb)
+{
+	uint16_t v = (uint16_t)((word << 8) | (word >> 8));
+	rgb[0] = (uint8_t)((v >> 11) << 3);
+	rgb[1] = (uint8_t)(((v >> 5) & 63) << 2);
+	rgb[2] = (uint8_t)((v & 31) << 3);
+}
+
+static void ppmPath(char *out, size_t size, const Run *run, uint32_t frame, const char *suffix)
+{
+	snprintf(out, size, "%s/L%u_F%lu%s.ppm", ppmDir, (unsigned)run->replay.level, (unsigned long)frame, suffix);
+}
+static void writePPM(const char *path, const uint8_t *rgb)
+{
+	FILE *f = fopen(path, "wb");
+	if (!f)
+	{
+		perror(path);
+		return;
+	}
+	fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+	fwrite(rgb, 3, SCREEN_WIDTH * SCREEN_HEIGHT, f);
+	fclose(f);
+}
+static int readPPM(const char *path, uint8_t *rgb)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f) return 0;
+	int w, h, max;
+	int ok = fscanf(f, "P6 %d %d %d", &w, &h, &max) == 3 && w == SCREEN_WIDTH && h == SCREEN_HEIGHT && fgetc(f) != EOF
+		&& fread(rgb, 3, SCREEN_WIDTH * SCREEN_HEIGHT, f) == SCREEN_WIDTH * SCREEN_HEIGHT;
+	fclose(f);
+	return ok;
+}
+
+static void saveFrame(const Run *run, uint32_t frame, const char *suffix)
+{
+	static uint8_t rgb[SCREEN_WIDTH * SCREEN_HEIGHT * 3];
+	char path[512];
+	for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+		pixelRGB(hostFramebuffer[i], &rgb[i * 3]);
+	ppmPath(path, sizeof(path), run, frame, suffix);
+	writePPM(path, rgb);
+}
+static void saveDiff(const Run *run, uint32_t frame)
+{
+	static uint8_t golden[SCREEN_WIDTH * SCREEN_HEIGHT * 3];
+	char path[512];
+	ppmPath(path, sizeof(path), run, frame, "_golden");
+	if (!readPPM(path, golden)) return;
+	for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+	{
+		uint8_t now[3];
+		uint8_t *g = &golden[i * 3];
+		pixelRGB(hostFramebuffer[i], now);
+		if (memcmp(now, g, 3) != 0)
+		{
+			g[0] = 255;
+			g[1] = 0;
+			g[2] = 0;
+		}
+		else
+		{
+			g[0] /= 4;
+			g[1] /= 4;
+			g[2] /= 4;
+		}
+	}
+	ppmPath(path, sizeof(path), run, frame, "_diff");
+	writePPM(path, golden);
+}
+
+// Play one recording, checking (or with update set, recording) hashes.
+// Returns the number of mismatches.
+static int playRun(Run *run, int update, uint32_t every)
+{
+	GameState g;
+	ReplayPlayer player;
+	display_begin();
+	arenaEnter(ARENA_PLAY);
+	resetPortalParticles();
+	governorForce(QUALITY_FULL);
+	effectsSeed(run->replay.seed);
+	gameReset(&g, levelInfo(run->replay.level));
+	renderSetCharacter(mainChar);
+	renderResetSprite();
+	renderPlayfield();
+	hudSetAttempt(1);
+	hudSetBest(0);
+	hudDraw();
+	replayPlayStart(&player, &run->replay);
+
+	int failures = 0;
+	int next = 0;
+	if (update) run->checks = 0;
+	for (uint32_t frame = 1; !replayPlayDone(&player); frame++)
+	{
+		gameStep(&g, replayPlayNext(&player));
+		renderScene(&g);
+		hudFrame(&g);
+		int last = g.dead || g.won || replayPlayDone(&player);
+		if (!last)
+			renderActors(&g);
+		if (update)
+		{
+			// Frames with the player cut off under the HUD are kept as well:
+			// the clipping there is easy to get wrong
+			int clipped = !last && (int)g.drawY - ROT_PAD < PLAYFIELD_TOP;
+			if ((frame % every == 0 || last || clipped) && run->checks < MAX_CHECKS)
+			{
+				run->frame[run->checks] = frame;
+				run->hash[run->checks++] = frameHash();
+				if (ppmDir) saveFrame(run, frame, "_golden");
+			}
+		}
+		else if (next < run->checks && run->frame[next] == frame)
+		{
+			uint32_t hash = frameHash();
+			if (hash != run->hash[next])
+			{
+				printf("level %u frame %lu: hash %08lx, golden %08lx\n", (unsigned)run->replay.level,
+					(unsigned long)frame, (unsigned long)hash, (unsigned long)run->hash[next]);
+				if (ppmDir)
+				{
+					saveFrame(run, frame, "");
+					saveDiff(run, frame);
+				}
+				failures++;
+			}
+			next++;
+		}
+		if (last) break;
+	}
+	if (!update && next < run->checks)
+	{
+		printf("level %u: run ended before frame %lu\n", (unsigned)run->replay.level, (unsigned long)run->frame[next]);
+		failures++;
+	}
+	return failures;
+}
+
+static int readGolden(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+	char line[512];
+	while (fgets(line, sizeof(line), f))
+	{
+		unsigned long frame, hash;
+		if (strncmp(line, "REPLAY ", 7) == 0 && numRuns < MAX_RUNS)
+		{
+			Run *run = &runs[numRuns];
+			uint32_t expected;
+			if (!replayParse(&run->replay, &expected, line))
+			{
+				fprintf(stderr, "%s: bad replay line: %s", path, line);
+				fclose(f);
+				return 0;
+			}
+			snprintf(run->replayLine, sizeof(run->replayLine), "%s", line);
+			run->checks = 0;
+			numRuns++;
+		}
+		else if (numRuns > 0 && sscanf(line, "FRAME %lu %lx", &frame, &hash) == 2)
+		{
+			Run *run = &runs[numRuns - 1];
+			if (run->checks < MAX_CHECKS)
+			{
+				run->frame[run->checks] = (uint32_t)frame;
+				run->hash[run->checks++] = (uint32_t)hash;
+			}
+		}
+	}
+	fclose(f);
+	return 1;
+}
+static int writeGolden(const char *path)
+{
+	FILE *f = fopen(path, "w");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+	fprintf(f, "# Golden framebuffer hashes, regenerate with: golden -u %s\n", path);
+	for (int r = 0; r < numRuns; r++)
+	{
+		fputs(runs[r].replayLine, f);
+		for (int c = 0; c < runs[r].checks; c++)
+			fprintf(f, "FRAME %lu %08lx\n", (unsigned long)runs[r].frame[c], (unsigned long)runs[r].hash[c]);
+	}
+	fclose(f);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = "src/host/golden_frames.txt";
+	int update = 0;
+	uint32_t every = 30;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-u") == 0)
+			update = 1;
+		else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+			every = (uint32_t)atoi(argv[++i]);
+		else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+			ppmDir = argv[++i];
+		else if (argv[i][0] != '-')
+			path = argv[i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-u] [-e frames] [-d dir] [file]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (every < 1) every = 1;
+	if (ppmDir) mkdir(ppmDir, 0777); // fine if it's already there
+	if (!readGolden(path)) return 2;
+	if (numRuns == 0)
+	{
+		fprintf(stderr, "%s: no REPLAY lines\n", path);
+		return 2;
+	}
+
+	timebaseInit();
+	int failures = 0;
+	int checked = 0;
+	for (int r = 0; r < numRuns; r++)
+	{
+		failures += playRun(&runs[r], update, every);
+		checked += runs[r].checks;
+	}
+	if (update)
+	{
+		if (!writeGolden(path)) return 2;
+		printf("%d frames recorded in %s\n", checked, path);
+		return 0;
+	}
+	printf("%d frames checked, %d mismatched\n", checked, failures);
+	return failures ? 1 : 0;
+}
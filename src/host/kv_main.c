@@ -0,0 +1,178 @@
+// Key-value store soak run against the file-backed flash.  Sets random
+// values on a handful of keys, services the store with random time
+// budgets, and now and then cuts the power in the middle of a flash
+// operation and reboots (kvInit over what's in the file).
+//
+//   kvtest [-n operations] [-s seed] [file]
+//
+// The file (default kv_flash.bin) starts out erased.  After every reboot
+// each key has to read back as a value it was actually given, no older
+// than the last one kvService finished writing: anything else, or a kvGet
+// that doesn't see the last kvSet, is a failure and the exit status is 1.
+// The report gives how often each store page was erased, which should be
+// about the same for all of them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "flash.h"
+#include "kv.h"
+
+#define NUM_KEYS 6
+// Values a key may have been given since it was last known written
+#define MAX_HISTORY 64
+
+static const uint8_t keyLength[NUM_KEYS] = { 1, 2, 4, 1, 2, 3 };
+
+typedef struct {
+	int known;     // has a value the store must come back with
+	uint32_t history[MAX_HISTORY]; // oldest (the one known written) first
+	int count;
+} Model;
+
+static Model model[NUM_KEYS];
+static uint32_t genState;
+static unsigned long failures;
+
+static uint32_t genNext(uint32_t range)
+{
+	genState = genState * 1664525u + 1013904223u;
+	return (genState >> 8) % range;
+}
+static uint8_t keyOf(int k)
+{
+	return (uint8_t)(KV_ATTEMPTS_0 + k);
+}
+static uint32_t masked(int k, uint32_t v)
+{
+	return keyLength[k] == 4 ? v : v & ((1u << (8 * keyLength[k])) - 1);
+}
+static int get(int k, uint32_t *v)
+{
+	*v = 0;
+	return kvGet(keyOf(k), v, keyLength[k]);
+}
+
+static void fail(const char *what, int k, uint32_t got)
+{
+	if (failures++ < 10)
+		fprintf(stderr, "key %d: %s (read %#lx)\n", keyOf(k), what, (unsigned long)got);
+}
+
+// Everything queued is in flash: only the newest value counts now
+static void allWritten(void)
+{
+	for (int k = 0; k < NUM_KEYS; k++)
+	{
+		if (model[k].count)
+		{
+			model[k].history[0] = model[k].history[model[k].count - 1];
+			model[k].count = 1;
+			model[k].known = 1;
+		}
+	}
+}
+
+static void reboot(void)
+{
+	hostFlashPowerCut = -1;
+	kvInit();
+	for (int k = 0; k < NUM_KEYS; k++)
+	{
+		uint32_t v;
+		int found = get(k, &v);
+		Model *m = &model[k];
+		int ok = !found && !m->known;
+		for (int i = 0; i < m->count && found && !ok; i++)
+			ok = m->history[i] == v;
+		if (!ok)
+			fail(found ? "came back with a value it was never given, or an older one" : "lost its value", k, v);
+		// Whatever came back is what it has now
+		m->count = found;
+		m->history[0] = v;
+		m->known = found;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long ops = 200000;
+	uint32_t seed = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			ops = strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-')
+			hostFlashFile = argv[i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-n operations] [-s seed] [file]\n", argv[0]);
+			return 2;
+		}
+	}
+	unlink(hostFlashFile);
+	if (!flashInit()) return 2;
+	kvInit();
+	genState = seed;
+
+	unsigned long sets = 0, services = 0, cuts = 0, reboots = 0;
+	for (unsigned long n = 0; n < ops; n++)
+	{
+		uint32_t action = genNext(100);
+		if (hostFlashPowerCut == -2 || action < 1)
+		{
+			if (hostFlashPowerCut == -2) cuts++;
+			reboots++;
+			reboot();
+		}
+		else if (action < 3 && hostFlashPowerCut == -1)
+		{
+			hostFlashPowerCut = (int32_t)genNext(200);
+		}
+		else if (action < 60)
+		{
+			int k = (int)genNext(NUM_KEYS);
+			Model *m = &model[k];
+			if (m->count == MAX_HISTORY)
+				continue;
+			// Small values so they often repeat, which queues nothing
+			uint32_t v = masked(k, genNext(8) == 0 ? genState : genNext(4));
+			sets++;
+			if (!kvSet(keyOf(k), &v, keyLength[k]))
+			{
+				fail("queue full", k, v);
+				continue;
+			}
+			if (!m->count || m->history[m->count - 1] != v)
+				m->history[m->count++] = v;
+			uint32_t back;
+			if (!get(k, &back) || back != v)
+				fail("kvGet doesn't see kvSet", k, back);
+		}
+		else
+		{
+			// Mostly menu-sized slices, sometimes too short for an erase
+			uint32_t budget = genNext(4) ? FLASH_ERASE_US : genNext(FLASH_ERASE_US);
+			services++;
+			if (!kvService(budget) && hostFlashPowerCut != -2)
+				allWritten();
+		}
+	}
+	reboots++;
+	reboot();
+
+	printf("%lu operations: %lu sets, %lu services, %lu reboots (%lu after a power cut)\n", ops, sets, services, reboots, cuts);
+	printf("erases per store page:");
+	uint32_t least = 0xffffffffu, most = 0;
+	for (int p = FLASH_KV_FIRST; p < FLASH_PAGES; p++)
+	{
+		printf(" %lu", (unsigned long)hostFlashErases[p]);
+		if (hostFlashErases[p] < least) least = hostFlashErases[p];
+		if (hostFlashErases[p] > most) most = hostFlashErases[p];
+	}
+	printf(" (spread %lu)\n", (unsigned long)(most - least));
+	printf("%lu failures\n", failures);
+	return failures ? 1 : 0;
+}
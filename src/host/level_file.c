@@ -0,0 +1,77 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "level_file.h"
+
+static void putLE32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+static uint32_t getLE32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+int levelFileWrite(const char *path, const uint8_t *rows, uint32_t length)
+{
+	FILE *f = fopen(path, "wb");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+	uint8_t header[LEVEL_FILE_HEADER] = { 'G', 'D', 'L', 'V' };
+	putLE32(header + 4, length);
+	putLE32(header + 8, LEVEL_ROWS);
+	int ok = fwrite(header, 1, LEVEL_FILE_HEADER, f) == LEVEL_FILE_HEADER
+		&& fwrite(rows, 1, (size_t)LEVEL_ROWS * length, f) == (size_t)LEVEL_ROWS * length;
+	ok = (fclose(f) == 0) && ok;
+	if (!ok) perror(path);
+	return ok;
+}
+
+int levelFileMap(const char *path, LevelInfo *level)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		perror(path);
+		return 0;
+	}
+	struct stat st;
+	if (fstat(fd, &st) < 0 || st.st_size < LEVEL_FILE_HEADER)
+	{
+		fprintf(stderr, "%s: not a level file\n", path);
+		close(fd);
+		return 0;
+	}
+	const uint8_t *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+	{
+		perror(path);
+		return 0;
+	}
+	uint32_t length = getLE32(base + 4);
+	uint32_t rows = getLE32(base + 8);
+	if (memcmp(base, "GDLV", 4) != 0 || rows != LEVEL_ROWS || length > INT_MAX
+		|| (uint64_t)st.st_size < LEVEL_FILE_HEADER + (uint64_t)rows * length)
+	{
+		fprintf(stderr, "%s: bad header (%lu rows of %lu columns)\n", path, (unsigned long)rows, (unsigned long)length);
+		munmap((void *)base, (size_t)st.st_size);
+		return 0;
+	}
+	// Levels are read front to back
+	madvise((void *)base, (size_t)st.st_size, MADV_SEQUENTIAL);
+	for (int r = 0; r < LEVEL_ROWS; r++)
+		level->rows[r] = base + LEVEL_FILE_HEADER + (size_t)r * length;
+	level->length = (int)length;
+	return 1;
+}
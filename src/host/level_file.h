@@ -0,0 +1,24 @@
+#ifndef LEVEL_FILE_H
+#define LEVEL_FILE_H
+#include <stdint.h>
+#include "levels.h"
+
+// ============================================
+// LEVEL FILES (host only)
+// Levels too big for src/levels/, kept on disk as
+//
+//   "GDLV" <length: u32 le> <rows: u32 le> <rows x length tile bytes>
+//
+// row 0 first, the same layout as the level_N_data arrays, so a mapped
+// file's LevelInfo row pointers point straight into the mapping.
+// ============================================
+#define LEVEL_FILE_HEADER 12
+
+// rows holds LEVEL_ROWS rows of length bytes back to back.  Returns 0 on
+// failure, having said why on stderr.
+int levelFileWrite(const char *path, const uint8_t *rows, uint32_t length);
+// Map a level file read-only and point level at it.  The mapping lasts
+// until the program exits.  Returns 0 on failure, having said why.
+int levelFileMap(const char *path, LevelInfo *level);
+
+#endif
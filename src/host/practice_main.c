@@ -0,0 +1,122 @@
+// Practice checkpoint check.  Takes the recorded runs in the golden-frame
+// file and, every few ticks along each one, saves a checkpoint, restores it
+// into a fresh game (after the effects RNG has been seeded with something
+// else, as a later attempt would leave it), and plays the rest of the
+// recording from there.  Every tick after the restore has to give the same
+// gameHash, and the same effects RNG output, as the run that was never
+// interrupted.
+//
+//   practicecheck [-e ticks] [file]
+//
+// -e is the spacing of the checkpoints (default 2); the file defaults to
+// src/host/golden_frames.txt, whose FRAME lines are passed over.  The
+// effects RNG is drawn once per tick, standing in for the renderer.  Exit
+// status is 1 if any restored run differs.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "effects.h"
+#include "game.h"
+#include "levels.h"
+#include "practice.h"
+#include "replay.h"
+
+#define MAX_TICKS 100000
+
+static uint8_t plan[MAX_TICKS];     // jump input per tick
+static uint32_t refHash[MAX_TICKS]; // uninterrupted run, after each tick
+static uint32_t refRand[MAX_TICKS];
+
+static void step(GameState *g, uint32_t *hash, uint32_t *rand)
+{
+	uint32_t tick = g->tick;
+	gameStep(g, plan[tick]);
+	hash[tick] = gameHash(g);
+	rand[tick] = quickRand();
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = "src/host/golden_frames.txt";
+	uint32_t spacing = 2;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+			spacing = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-')
+			path = argv[i];
+		else
+			spacing = 0;
+	}
+	if (spacing == 0)
+	{
+		fprintf(stderr, "usage: %s [-e ticks] [file]\n", argv[0]);
+		return 2;
+	}
+	FILE *f = fopen(path, "r");
+	if (!f)
+	{
+		perror(path);
+		return 2;
+	}
+
+	char line[512];
+	unsigned long checkpoints = 0, inAir = 0, differ = 0;
+	while (fgets(line, sizeof(line), f))
+	{
+		Replay r;
+		uint32_t finalHash;
+		if (!replayParse(&r, &finalHash, line))
+			continue;
+		const LevelInfo *level = levelInfo(r.level);
+		ReplayPlayer p;
+		uint32_t ticks = 0;
+		replayPlayStart(&p, &r);
+		while (!replayPlayDone(&p) && ticks < MAX_TICKS)
+			plan[ticks++] = (uint8_t)replayPlayNext(&p);
+
+		GameState g;
+		gameReset(&g, level);
+		effectsSeed(r.seed);
+		while (g.tick < ticks && !g.dead && !g.won)
+			step(&g, refHash, refRand);
+		uint32_t end = g.tick;
+
+		unsigned long runDiffer = 0;
+		for (uint32_t at = 1; at < end; at += spacing)
+		{
+			gameReset(&g, level);
+			effectsSeed(r.seed);
+			while (g.tick < at)
+				step(&g, refHash, refRand);
+			practiceReset();
+			practiceSave(&g);
+			checkpoints++;
+			inAir += g.isInAir;
+
+			GameState k;
+			gameReset(&k, level);
+			effectsSeed(r.seed ^ 0x5a5a5a5a);
+			practiceRestore(&k, level);
+			while (k.tick < end)
+			{
+				uint32_t tick = k.tick;
+				gameStep(&k, plan[tick]);
+				uint32_t h = gameHash(&k), q = quickRand();
+				if (h != refHash[tick] || q != refRand[tick])
+				{
+					if (differ + runDiffer < 10)
+						fprintf(stderr, "level %d: restored at tick %lu, differs at tick %lu\n", r.level + 1,
+							(unsigned long)at, (unsigned long)tick);
+					runDiffer++;
+					break;
+				}
+			}
+		}
+		differ += runDiffer;
+		printf("level %d: %lu ticks, %s\n", r.level + 1, (unsigned long)end, runDiffer ? "DIFFERS" : "ok");
+	}
+	fclose(f);
+	printf("%lu checkpoints (%lu in the air), %lu differ\n", checkpoints, inAir, differ);
+	return differ ? 1 : 0;
+}
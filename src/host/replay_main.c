@@ -0,0 +1,73 @@
+// Host replay checker.  Reads REPLAY lines (as printed over serial when a
+// level is won) from a file or stdin, re-runs each one headless as fast as
+// possible, and says whether it ends the way the device said it did.
+//
+//   replay [-n repeats] [file]
+//
+// Exit status is non-zero if any replay doesn't reproduce.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "replay.h"
+
+static double seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+	int repeats = 1000;
+	FILE *in = stdin;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			repeats = atoi(argv[++i]);
+		else if ((in = fopen(argv[i], "r")) == NULL)
+		{
+			perror(argv[i]);
+			return 2;
+		}
+	}
+	if (repeats < 1) repeats = 1;
+
+	char line[512];
+	int failures = 0;
+	int runs = 0;
+	while (fgets(line, sizeof(line), in))
+	{
+		// Serial captures can have other output ahead of the replay on a line
+		char *start = strstr(line, "REPLAY ");
+		if (!start) continue;
+		Replay r;
+		uint32_t expected;
+		if (!replayParse(&r, &expected, start))
+		{
+			printf("bad replay line: %s", start);
+			failures++;
+			continue;
+		}
+		GameState g;
+		double t0 = seconds();
+		for (int i = 0; i < repeats; i++)
+			replayFastForward(&r, &g);
+		double elapsed = seconds() - t0;
+		uint32_t hash = gameHash(&g);
+		int ok = (hash == expected) && g.won;
+		printf("level %u ticks %lu %s hash %08lx %s  %.0f ticks/s\n",
+			(unsigned)r.level, (unsigned long)g.tick, g.won ? "won" : (g.dead ? "died" : "unfinished"),
+			(unsigned long)hash, ok ? "ok" : "MISMATCH",
+			elapsed > 0 ? (double)g.tick * repeats / elapsed : 0.0);
+		if (!ok) failures++;
+		runs++;
+	}
+	if (runs == 0 && failures == 0)
+	{
+		fprintf(stderr, "no REPLAY lines found\n");
+		return 2;
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,457 @@
+// Level solver and reachability check.  Runs the real game core (game.c)
+// over every way a level can be played and says whether it can be
+// finished, where the timing is tightest and where a player can get into
+// a position they can't get out of.  Levels are solved in parallel, one
+// per thread.
+//
+//   solve [-j threads] [-w windows] [level file...]
+//
+// With no files, every level in the build (levels.c) is checked; files are
+// in the level_file.h format.  Exit status is 1 if any level can't be
+// finished, so it can gate a build.
+//
+// The jump input only matters on a tick that starts on the ground, and a
+// grounded state is fixed by its tick and the height it stands at: scroll
+// advances the same way every tick, and velocity and air time are zero.
+// So the search is over those (tick, height) nodes.  From each one there
+// are two moves, jump or don't, each simulated with gameStep until the
+// player is on the ground again, dead or through the portal.  A forward
+// pass finds every reachable node, a backward pass marks the ones from
+// which the portal can still be reached.
+//
+// Per level the report gives:
+//   - whether it can be finished, and a REPLAY line for a run that does
+//     (built-in levels; check it with the replay tool)
+//   - the tightest windows: the number of consecutive ticks a jump can
+//     start on and still lead to the portal, smallest first.  A 1 tick
+//     window is a frame-perfect jump.
+//   - dead-end sections: column ranges a player can enter alive but
+//     never leave alive
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "game.h"
+#include "levels.h"
+#include "replay.h"
+#include "level_file.h"
+
+#define MAX_LEVELS 64
+#define MAX_LISTED 32                 // windows and dead ends kept per level
+#define HEIGHTS (ROWS_VISIBLE + 1)    // the floor and the top of each row
+// Ticks a move can take before landing; a pad launch is under 40
+#define RING_TICKS 128
+
+#define TARGET_WIN -1
+#define TARGET_DEAD -2
+
+#define NODE_REACHED 0x01
+#define NODE_WINNABLE 0x02
+
+typedef struct {
+	int32_t to;    // node landed on, TARGET_WIN or TARGET_DEAD
+	uint32_t tick; // tick the move ended on
+} Move;
+
+typedef struct {
+	uint8_t flags;
+	Move move[2]; // 0: don't jump, 1: jump
+} Node;
+
+typedef struct {
+	uint32_t firstTick; // first tick a jump works from
+	uint32_t ticks;     // how many in a row do
+	int height;
+} Window;
+
+typedef struct {
+	uint32_t fromTick;
+	uint32_t toTick;    // last tick alive
+	int height;
+} DeadEnd;
+
+// One instance per level; nothing in it is shared between threads
+typedef struct {
+	const LevelInfo *level;
+	uint32_t maxTicks;
+	Node *nodes; // maxTicks * HEIGHTS
+	GameState ring[RING_TICKS][HEIGHTS];
+	uint32_t reached;
+	uint32_t winnable;
+	uint32_t furthestTick;
+} Solver;
+
+typedef struct {
+	const char *name;
+	LevelInfo level;
+	int builtIn;   // index into levels[], or -1
+	int completable;
+	char *report;  // filled in by the worker
+	size_t reportSize;
+	int hasReplay;
+	Replay replay; // a winning run, for built-in levels
+	uint32_t hash;
+} Job;
+
+static Job jobs[MAX_LEVELS];
+static int numJobs;
+static int numWindows = 5;
+static int nextJob;
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Column under the player's left edge.  scrollOffset is the same for
+// every state on a tick; rebuild it the way gameStep does.
+static double columnAtTick(uint32_t tick)
+{
+	float scroll = SCROLL_START;
+	for (uint32_t t = 0; t < tick; t++)
+		scroll += (float)SCROLL_SPEED;
+	return (scroll + PLAYER_X) / OBSTACLE_SIZE;
+}
+
+static int heightIndex(const GameState *g)
+{
+	return (int)(g->jumpHeight / OBSTACLE_SIZE + 0.5);
+}
+
+static Node *node(Solver *s, uint32_t tick, int height)
+{
+	return &s->nodes[(size_t)tick * HEIGHTS + height];
+}
+
+// Play one move from a grounded state until it's decided
+static Move playMove(Solver *s, const GameState *from, int jump)
+{
+	GameState g = *from;
+	Move m;
+	gameStep(&g, jump);
+	while (g.isInAir && !g.dead && !g.won && g.tick < s->maxTicks)
+		gameStep(&g, 0);
+	m.tick = g.tick;
+	if (g.dead || g.tick >= s->maxTicks || g.tick - from->tick >= RING_TICKS)
+	{
+		m.to = TARGET_DEAD;
+		return m;
+	}
+	if (g.won)
+	{
+		m.to = TARGET_WIN;
+		return m;
+	}
+	int h = heightIndex(&g);
+	m.to = (int32_t)((size_t)g.tick * HEIGHTS + h);
+	Node *n = node(s, g.tick, h);
+	if (!(n->flags & NODE_REACHED))
+	{
+		n->flags |= NODE_REACHED;
+		s->ring[g.tick % RING_TICKS][h] = g;
+		s->reached++;
+	}
+	return m;
+}
+
+static int moveWins(const Solver *s, const Move *m)
+{
+	return m->to == TARGET_WIN || (m->to >= 0 && (s->nodes[m->to].flags & NODE_WINNABLE));
+}
+
+static int solverRun(Solver *s, const LevelInfo *level)
+{
+	s->level = level;
+	// Every run ends within this many ticks; past it the portal has passed
+	s->maxTicks = (uint32_t)((level->length * (double)OBSTACLE_SIZE - SCROLL_START) / 2.0) + RING_TICKS;
+	s->nodes = calloc((size_t)s->maxTicks * HEIGHTS, sizeof(Node));
+	if (!s->nodes) return 0;
+	s->reached = 1;
+	s->winnable = 0;
+	s->furthestTick = 0;
+
+	GameState *start = &s->ring[0][0];
+	gameReset(start, level);
+	node(s, 0, 0)->flags = NODE_REACHED;
+
+	// Forward: moves only go forward in time, so tick order visits every
+	// node after everything that can reach it
+	for (uint32_t t = 0; t < s->maxTicks; t++)
+	{
+		for (int h = 0; h < HEIGHTS; h++)
+		{
+			Node *n = node(s, t, h);
+			if (!(n->flags & NODE_REACHED)) continue;
+			const GameState from = s->ring[t % RING_TICKS][h];
+			for (int jump = 0; jump < 2; jump++)
+			{
+				n->move[jump] = playMove(s, &from, jump);
+				if (n->move[jump].tick > s->furthestTick && n->move[jump].to != TARGET_WIN)
+					s->furthestTick = n->move[jump].tick;
+			}
+		}
+	}
+	// Backward: winnable if either move is
+	for (uint32_t t = s->maxTicks; t-- > 0;)
+	{
+		for (int h = 0; h < HEIGHTS; h++)
+		{
+			Node *n = node(s, t, h);
+			if ((n->flags & NODE_REACHED) && (moveWins(s, &n->move[0]) || moveWins(s, &n->move[1])))
+			{
+				n->flags |= NODE_WINNABLE;
+				s->winnable++;
+			}
+		}
+	}
+	return 1;
+}
+
+// Windows end where waiting any longer loses: count back the ticks on the
+// same height a jump would have worked from.  Returns how many windows
+// there are, keeping the tightest max sorted in out.
+static int collectWindows(Solver *s, Window *out, int max)
+{
+	int count = 0;
+	int kept = 0;
+	for (uint32_t t = 0; t < s->maxTicks; t++)
+	{
+		for (int h = 0; h < HEIGHTS; h++)
+		{
+			Node *n = node(s, t, h);
+			if (!(n->flags & NODE_WINNABLE) || moveWins(s, &n->move[0]) || !moveWins(s, &n->move[1]))
+				continue;
+			uint32_t first = t;
+			while (first > 0)
+			{
+				Node *p = node(s, first - 1, h);
+				if (!(p->flags & NODE_REACHED) || p->move[0].to != (int32_t)((size_t)first * HEIGHTS + h)
+					|| !moveWins(s, &p->move[1]))
+					break;
+				first--;
+			}
+			Window w = { first, t - first + 1, h };
+			count++;
+			int i = kept < max ? kept++ : max;
+			while (i > 0 && out[i - 1].ticks > w.ticks)
+			{
+				if (i < max) out[i] = out[i - 1];
+				i--;
+			}
+			if (i < max) out[i] = w;
+		}
+	}
+	return count;
+}
+
+// Last tick a doomed node's best line stays alive
+static uint32_t doomTick(Solver *s, int32_t index, uint32_t *memo)
+{
+	if (memo[index]) return memo[index];
+	uint32_t best = 0;
+	for (int jump = 0; jump < 2; jump++)
+	{
+		const Move *m = &s->nodes[index].move[jump];
+		uint32_t end = m->to >= 0 ? doomTick(s, m->to, memo) : m->tick;
+		if (end > best) best = end;
+	}
+	return memo[index] = best;
+}
+
+// Moves from a winnable node that land alive on one that isn't, merged
+// into sections where they overlap.  Returns how many sections there are,
+// keeping the first max.
+static int collectDeadEnds(Solver *s, DeadEnd *out, int max)
+{
+	uint32_t *memo = calloc((size_t)s->maxTicks * HEIGHTS, sizeof(uint32_t));
+	if (!memo) return 0;
+	int count = 0;
+	DeadEnd last = { 0, 0, 0 };
+	// Fill the memo from the far end so the recursion stays shallow
+	for (uint32_t t = s->maxTicks; t-- > 0;)
+	{
+		for (int h = 0; h < HEIGHTS; h++)
+		{
+			Node *n = node(s, t, h);
+			if ((n->flags & NODE_REACHED) && !(n->flags & NODE_WINNABLE))
+				doomTick(s, (int32_t)((size_t)t * HEIGHTS + h), memo);
+		}
+	}
+	for (uint32_t t = 0; t < s->maxTicks; t++)
+	{
+		for (int h = 0; h < HEIGHTS; h++)
+		{
+			Node *n = node(s, t, h);
+			if (!(n->flags & NODE_WINNABLE)) continue;
+			for (int jump = 0; jump < 2; jump++)
+			{
+				int32_t to = n->move[jump].to;
+				if (to < 0 || (s->nodes[to].flags & NODE_WINNABLE)) continue;
+				DeadEnd d = { t, doomTick(s, to, memo), h };
+				if (count > 0 && d.fromTick <= last.toTick)
+				{
+					if (d.toTick > last.toTick) last.toTick = d.toTick;
+				}
+				else
+				{
+					last = d;
+					count++;
+				}
+				if (count <= max) out[count - 1] = last;
+			}
+		}
+	}
+	free(memo);
+	return count;
+}
+
+// Latest jumps that still finish, as a replay
+static void solutionReplay(Solver *s, int levelIndex, Replay *r, uint32_t *hash)
+{
+	GameState g;
+	gameReset(&g, s->level);
+	replayBegin(r, (uint8_t)levelIndex, 0);
+	uint32_t t = 0;
+	int h = 0;
+	for (;;)
+	{
+		Node *n = node(s, t, h);
+		int jump = moveWins(s, &n->move[0]) ? 0 : 1;
+		const Move *m = &n->move[jump];
+		replayRecord(r, jump);
+		gameStep(&g, jump);
+		while (g.tick < m->tick)
+		{
+			replayRecord(r, 0);
+			gameStep(&g, 0);
+		}
+		if (m->to < 0) break;
+		t = (uint32_t)m->to / HEIGHTS;
+		h = m->to % HEIGHTS;
+	}
+	*hash = gameHash(&g);
+}
+
+static void solveJob(Job *job)
+{
+	FILE *out = open_memstream(&job->report, &job->reportSize);
+	if (!out) return;
+	Solver *s = malloc(sizeof(Solver));
+	if (!s || !solverRun(s, &job->level))
+	{
+		fprintf(out, "%s: out of memory\n", job->name);
+		job->completable = 0;
+		free(s);
+		fclose(out);
+		return;
+	}
+	job->completable = (node(s, 0, 0)->flags & NODE_WINNABLE) != 0;
+	fprintf(out, "%s: %d columns, %s (%lu states reachable, %lu winnable)\n", job->name, job->level.length,
+		job->completable ? "completable" : "NOT completable", (unsigned long)s->reached, (unsigned long)s->winnable);
+	if (!job->completable)
+	{
+		fprintf(out, "  furthest reached: column %.1f (dies on tick %lu)\n", columnAtTick(s->furthestTick),
+			(unsigned long)s->furthestTick);
+	}
+	else
+	{
+		Window windows[MAX_LISTED];
+		int max = numWindows < MAX_LISTED ? numWindows : MAX_LISTED;
+		int found = collectWindows(s, windows, max);
+		fprintf(out, "  %d jump windows, tightest:\n", found);
+		for (int i = 0; i < found && i < max; i++)
+		{
+			const Window *w = &windows[i];
+			fprintf(out, "    column %6.1f height %d: %lu tick%s (%.0f ms)\n", columnAtTick(w->firstTick), w->height,
+				(unsigned long)w->ticks, w->ticks == 1 ? "" : "s", w->ticks * GAME_TICK_MS);
+		}
+		if (job->builtIn >= 0)
+		{
+			solutionReplay(s, job->builtIn, &job->replay, &job->hash);
+			job->hasReplay = !job->replay.truncated;
+		}
+	}
+	DeadEnd deadEnds[MAX_LISTED];
+	int numDeadEnds = collectDeadEnds(s, deadEnds, MAX_LISTED);
+	fprintf(out, "  %d dead-end section%s%s\n", numDeadEnds, numDeadEnds == 1 ? "" : "s", numDeadEnds ? ":" : "");
+	for (int i = 0; i < numDeadEnds && i < MAX_LISTED; i++)
+	{
+		fprintf(out, "    columns %6.1f - %6.1f from height %d\n", columnAtTick(deadEnds[i].fromTick),
+			columnAtTick(deadEnds[i].toTick), deadEnds[i].height);
+	}
+	free(s->nodes);
+	free(s);
+	fclose(out);
+}
+
+static void printLine(const char *line)
+{
+	fputs(line, stdout);
+}
+
+static void *worker(void *arg)
+{
+	(void)arg;
+	for (;;)
+	{
+		pthread_mutex_lock(&jobLock);
+		int j = nextJob++;
+		pthread_mutex_unlock(&jobLock);
+		if (j >= numJobs) return NULL;
+		solveJob(&jobs[j]);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	static char names[NUM_LEVELS][16];
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+			numWindows = atoi(argv[++i]);
+		else if (argv[i][0] != '-' && numJobs < MAX_LEVELS)
+		{
+			if (!levelFileMap(argv[i], &jobs[numJobs].level)) return 2;
+			jobs[numJobs].name = argv[i];
+			jobs[numJobs++].builtIn = -1;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-j threads] [-w windows] [level file...]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (numJobs == 0)
+	{
+		for (int l = 0; l < NUM_LEVELS; l++)
+		{
+			snprintf(names[l], sizeof(names[l]), "level %d", l);
+			jobs[numJobs].name = names[l];
+			jobs[numJobs].level = levels[l];
+			jobs[numJobs++].builtIn = l;
+		}
+	}
+	if (threads < 1) threads = 1;
+	if (threads > numJobs) threads = numJobs;
+	if (numWindows < 0) numWindows = 0;
+
+	pthread_t ids[MAX_LEVELS];
+	for (int t = 0; t < threads; t++)
+		pthread_create(&ids[t], NULL, worker, NULL);
+	for (int t = 0; t < threads; t++)
+		pthread_join(ids[t], NULL);
+
+	int failures = 0;
+	for (int j = 0; j < numJobs; j++)
+	{
+		if (jobs[j].report) fputs(jobs[j].report, stdout);
+		free(jobs[j].report);
+		if (jobs[j].hasReplay)
+		{
+			fputs("  ", stdout);
+			replayWrite(&jobs[j].replay, jobs[j].hash, printLine);
+		}
+		if (!jobs[j].completable) failures++;
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,254 @@
+// Giant-level stress run.  Memory-maps a level file far longer than
+// anything in src/levels/, plays it to the portal headless with a scripted
+// bot, and reports how fast the game core gets through it and how far the
+// float scrollOffset has drifted from where exact arithmetic would put it.
+//
+//   stress [-g columns] [-s seed] [file]
+//
+// -g writes a generated level of that many columns to the file first
+// (default 200000; an existing file is used as it is otherwise).  The file
+// (default stress_level.bin) is in the level_file.h format, so LevelInfo's
+// row pointers point straight into the mapping and nothing is copied.
+//
+// The report has three parts: the bot's run (columns survived, ticks,
+// jumps), a timed replay of the bot's inputs through gameStep alone
+// (columns per second), and a sweep of the scroll arithmetic on its own,
+// past the end of the level, giving the column at which each precision
+// threshold is first crossed.  Exit status is 1 if the bot dies.
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "game.h"
+#include "levels.h"
+#include "level_file.h"
+
+// Longest the bot looks ahead: a full jump is about 18 ticks
+#define LOOKAHEAD_TICKS 24
+// Columns of open floor at each end of a generated level
+#define RUN_IN_COLUMNS 12
+
+static double seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint32_t genState;
+static uint32_t genNext(uint32_t range)
+{
+	genState = genState * 1664525u + 1013904223u;
+	return (genState >> 16) % range;
+}
+
+// Open floor broken up by the obstacles the built-in levels use: single
+// spikes, low blocks to hop onto (and off, over a spike), and pads, each
+// followed by enough floor to land
+static int generateLevel(const char *path, uint32_t length, uint32_t seed)
+{
+	uint8_t *rows = calloc((size_t)LEVEL_ROWS * length, 1);
+	if (!rows)
+	{
+		fprintf(stderr, "out of memory for %lu columns\n", (unsigned long)length);
+		return 0;
+	}
+	genState = seed;
+	uint8_t *ground = rows;
+	uint32_t col = RUN_IN_COLUMNS;
+	while (col + 8 + RUN_IN_COLUMNS < length)
+	{
+		switch (genNext(4))
+		{
+		case 0:
+			ground[col++] = TILE_SPIKE;
+			break;
+		case 1:
+			ground[col++] = TILE_PAD;
+			break;
+		default:
+			// a step up, a short walk along it, and down again, sometimes
+			// over a spike
+			for (uint32_t n = 2 + genNext(3); n > 0; n--)
+				ground[col++] = TILE_BLOCK;
+			if (genNext(2))
+				ground[col++] = TILE_SPIKE;
+			break;
+		}
+		col += 5 + genNext(5);
+	}
+
+	int ok = levelFileWrite(path, rows, length);
+	free(rows);
+	return ok;
+}
+
+// Does the run get through the next ticks if it jumps only at tick jumpAt
+// (-1 for never)?  A jump counts as made once it lands, whatever comes
+// after, and so does reaching the portal.
+static int survives(const GameState *from, int jumpAt, int ticks)
+{
+	GameState g = *from;
+	for (int t = 0; t < ticks; t++)
+	{
+		gameStep(&g, t == jumpAt);
+		if (g.dead) return 0;
+		if (g.won || (jumpAt >= 0 && t > jumpAt && !g.isInAir)) return 1;
+	}
+	return 1;
+}
+// Jump as late as possible: hold off while not jumping at all, or jumping
+// on some later tick, still gets through
+static int botJump(const GameState *g)
+{
+	if (g->isInAir) return 0;
+	for (int jumpAt = -1; jumpAt < LOOKAHEAD_TICKS; jumpAt++)
+	{
+		if (jumpAt != 0 && survives(g, jumpAt, LOOKAHEAD_TICKS)) return 0;
+	}
+	return 1;
+}
+
+// Scroll after tick n if every addition were exact
+static double exactScroll(uint64_t tick)
+{
+	return (double)SCROLL_START + (double)tick * 2.8;
+}
+static double columnOf(double scroll)
+{
+	return (scroll + PLAYER_X) / OBSTACLE_SIZE;
+}
+
+// Advance scrollOffset the way gameStep does until it stops moving and
+// report where each precision threshold is first crossed.  Drawing and
+// collision both work from the same scrollOffset, so drift alone only puts
+// the run behind or ahead of the schedule the level was designed to; a
+// step that has moved off SCROLL_SPEED changes how far a jump carries,
+// which is what breaks levels.
+static void precisionSweep(void)
+{
+	static const struct {
+		double drift;
+		const char *meaning;
+	} drifts[] = {
+		{ 0.5, "positions round to a different pixel than exact arithmetic" },
+		{ 1.0, "a pixel off the designed schedule" },
+		{ OBSTACLE_SIZE, "a whole tile (about 6 ticks) off the designed schedule" },
+	};
+	static const struct {
+		float error;
+		const char *meaning;
+	} steps[] = {
+		{ 0.01f, "jumps carry 1% further or shorter than designed" },
+		{ 0.10f, "jumps carry 10% off: tight gaps can no longer be cleared" },
+		{ 1.0f, "scrolling stops: the level can't be finished" },
+	};
+	const int numDrifts = (int)(sizeof(drifts) / sizeof(drifts[0]));
+	const int numSteps = (int)(sizeof(steps) / sizeof(steps[0]));
+	int nextDrift = 0;
+	int nextStep = 0;
+	float scroll = SCROLL_START;
+	printf("\nscroll precision (float scrollOffset += %.1ff per tick)\n", (double)SCROLL_SPEED);
+	for (uint64_t tick = 1; nextStep < numSteps; tick++)
+	{
+		float before = scroll;
+		scroll += (float)SCROLL_SPEED;
+		float step = scroll - before;
+		double drift = (double)scroll - exactScroll(tick);
+		while (nextDrift < numDrifts && fabs(drift) >= drifts[nextDrift].drift)
+		{
+			printf("  column %9.0f (tick %llu, %.1f h of play): drift %.1f px, %s\n", columnOf(scroll),
+				(unsigned long long)tick, tick * GAME_TICK_MS / 3.6e6, drift, drifts[nextDrift].meaning);
+			nextDrift++;
+		}
+		while (nextStep < numSteps && fabsf(step - (float)SCROLL_SPEED) >= steps[nextStep].error * (float)SCROLL_SPEED)
+		{
+			printf("  column %9.0f (tick %llu, %.1f h of play): step %.4f px, %s\n", columnOf(scroll),
+				(unsigned long long)tick, tick * GAME_TICK_MS / 3.6e6, (double)step, steps[nextStep].meaning);
+			nextStep++;
+		}
+	}
+	// gamePortalScreenX works in int pixels
+	printf("  column %9d: length * OBSTACLE_SIZE overflows int\n", INT_MAX / OBSTACLE_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = "stress_level.bin";
+	uint32_t generate = 0;
+	uint32_t seed = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+			generate = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-')
+			path = argv[i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-g columns] [-s seed] [file]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (!generate && access(path, R_OK) != 0)
+		generate = 200000;
+	if (generate)
+	{
+		if (generate < 2 * RUN_IN_COLUMNS)
+			generate = 2 * RUN_IN_COLUMNS;
+		if (!generateLevel(path, generate, seed)) return 2;
+		printf("generated %lu columns into %s\n", (unsigned long)generate, path);
+	}
+
+	LevelInfo level;
+	if (!levelFileMap(path, &level)) return 2;
+
+	// Bot run, keeping its inputs for the timed replay
+	size_t maxTicks = (size_t)((level.length * (double)OBSTACLE_SIZE - SCROLL_START) / 2.0) + 1;
+	uint8_t *inputs = calloc(maxTicks / 8 + 1, 1);
+	if (!inputs)
+	{
+		fprintf(stderr, "out of memory for %lu ticks\n", (unsigned long)maxTicks);
+		return 2;
+	}
+	GameState g;
+	gameReset(&g, &level);
+	uint32_t jumps = 0;
+	double t0 = seconds();
+	while (!g.dead && !g.won && g.tick < maxTicks)
+	{
+		int jump = botJump(&g);
+		if (jump)
+		{
+			inputs[g.tick / 8] |= (uint8_t)(1u << (g.tick % 8));
+			jumps++;
+		}
+		gameStep(&g, jump);
+	}
+	double botTime = seconds() - t0;
+	uint32_t ticks = g.tick;
+	double reached = columnOf(g.scrollOffset);
+	printf("level %s: %d columns\n", path, level.length);
+	printf("bot %s at column %.0f after %lu ticks, %lu jumps (%.2f s with look-ahead)\n",
+		g.won ? "won" : g.dead ? "died" : "stalled", reached, (unsigned long)ticks, (unsigned long)jumps, botTime);
+	printf("scroll at the end %.4f, exact %.4f, drift %+.4f px\n", (double)g.scrollOffset,
+		exactScroll(ticks), (double)g.scrollOffset - exactScroll(ticks));
+
+	// The same inputs again, timing the core alone
+	gameReset(&g, &level);
+	t0 = seconds();
+	for (uint32_t t = 0; t < ticks; t++)
+		gameStep(&g, (inputs[t / 8] >> (t % 8)) & 1);
+	double coreTime = seconds() - t0;
+	if (coreTime <= 0) coreTime = 1e-9;
+	printf("core: %lu ticks in %.3f s, %.0f ticks/s, %.0f columns/s (%.0fx real time)\n", (unsigned long)ticks,
+		coreTime, ticks / coreTime, (reached > 0 ? reached : 0) / coreTime, ticks * GAME_TICK_MS / 1000.0 / coreTime);
+	free(inputs);
+
+	precisionSweep();
+	return (g.dead || !g.won) ? 1 : 0;
+}
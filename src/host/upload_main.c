@@ -0,0 +1,101 @@
+// Level upload stand-in: the board's side of the upload protocol
+// (src/upload.h) on a pseudo-terminal, over a file standing in for flash,
+// so tools/level_upload.py can be tried without a board.
+//
+//   uploadtest [-1] [file]
+//
+// Prints the terminal's name; send to it with
+//   python tools/level_upload.py /dev/pts/N level.png
+// It takes frames the way the menu does, every 10 ms, and prints each
+// level that comes in (row 0 at the bottom: . empty, ^ spike, # block,
+// = pad).  -1 exits after the first.  The file (default upload_flash.bin)
+// keeps the level from one run to the next, as flash would.
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "flash.h"
+#include "serial.h"
+#include "upload.h"
+
+static void printLevel(const LevelInfo *level)
+{
+	static const char tileChar[] = ".^#=";
+	printf("level %d: %d columns\n", LEVEL_UPLOADED + 1, level->length);
+	for (int r = LEVEL_ROWS - 1; r >= 0; r--)
+	{
+		for (int i = 0; i < level->length; i++)
+			putchar(level->rows[r][i] < 4 ? tileChar[level->rows[r][i]] : '?');
+		putchar('\n');
+	}
+	fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+	int once = 0;
+	int opt;
+	while ((opt = getopt(argc, argv, "1")) != -1)
+	{
+		if (opt == '1')
+		{
+			once = 1;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-1] [file]\n", argv[0]);
+			return 2;
+		}
+	}
+	hostFlashFile = optind < argc ? argv[optind] : "upload_flash.bin";
+	if (!flashInit())
+		return 1;
+
+	int pty = posix_openpt(O_RDWR | O_NOCTTY);
+	if (pty < 0 || grantpt(pty) != 0 || unlockpt(pty) != 0)
+	{
+		perror("pty");
+		return 1;
+	}
+	const char *name = ptsname(pty);
+	// Raw from the start, and held open so it stays that way between senders
+	int port = open(name, O_RDWR | O_NOCTTY);
+	struct termios tio;
+	if (port < 0 || tcgetattr(port, &tio) != 0)
+	{
+		perror(name);
+		return 1;
+	}
+	cfmakeraw(&tio);
+	tcsetattr(port, TCSANOW, &tio);
+	hostSerialFd = pty;
+	serialInit();
+
+	uploadInit();
+	if (numLevels > NUM_LEVELS)
+		printLevel(&uploadedLevel);
+	printf("%s\n", name);
+	fflush(stdout);
+	for (;;)
+	{
+		int event = uploadPoll(FLASH_ERASE_US);
+		if (event == UPLOAD_CLEARED)
+		{
+			printf("upload started\n");
+			fflush(stdout);
+		}
+		else if (event == UPLOAD_DONE)
+		{
+			printLevel(&uploadedLevel);
+			if (once)
+			{
+				usleep(200000); // for the sender to read its answer
+				return 0;
+			}
+		}
+		usleep(10000);
+	}
+}
@@ -0,0 +1,147 @@
+#include "hud.h"
+#include "display.h"
+#include "font5x7.h"
+#include "governor.h"
+
+#define HUD_CHAR_ADVANCE (FONT_WIDTH + 2) // printText: 5 pixel glyph + 2 pixel gap
+#define HUD_TEXT_Y 1
+#define HUD_ATTEMPT_DIGITS 4
+#define HUD_ATTEMPT_X (1 + HUD_CHAR_ADVANCE)  // after the A
+#define HUD_BEST_DIGITS 3
+#define HUD_BEST_X (SCREEN_WIDTH - 1 - (HUD_BEST_DIGITS + 1) * HUD_CHAR_ADVANCE + 2)
+#define HUD_BAR_X (HUD_ATTEMPT_X + HUD_ATTEMPT_DIGITS * HUD_CHAR_ADVANCE + 3)
+#define HUD_BAR_WIDTH (HUD_BEST_X - 4 - HUD_BAR_X)
+#define HUD_BAR_Y 2
+#define HUD_BAR_HEIGHT 5
+#define HUD_NONE 0xff
+
+_Static_assert(HUD_TEXT_Y + FONT_HEIGHT <= HUD_HEIGHT, "HUD text doesn't fit in the strip");
+_Static_assert(HUD_BAR_WIDTH > 0 && HUD_BAR_WIDTH < HUD_NONE, "HUD bar doesn't fit across the screen");
+
+static uint16_t attempt = 1;
+static uint8_t best;
+// What is on the panel now; 0 (and HUD_NONE) mean unknown, so the next
+// update sends it
+static char attemptOnScreen[HUD_ATTEMPT_DIGITS];
+static char bestOnScreen[HUD_BEST_DIGITS];
+static uint8_t barOnScreen;    // filled columns
+static uint8_t markerOnScreen; // column of the best marker
+
+static void printChar(char c, int x, uint16_t colour)
+{
+	char text[2] = { c, 0 };
+	printText(text, (uint16_t)x, HUD_TEXT_Y, colour, 0);
+}
+
+static void updateAttempt(void)
+{
+	// Left aligned, blanks after
+	char digits[HUD_ATTEMPT_DIGITS];
+	uint16_t value = attempt > 9999 ? 9999 : attempt;
+	int n = 0;
+	for (uint16_t v = value; v > 0 || n == 0; v /= 10) n++;
+	for (int i = HUD_ATTEMPT_DIGITS - 1; i >= 0; i--)
+	{
+		if (i >= n)
+		{
+			digits[i] = ' ';
+		}
+		else
+		{
+			digits[i] = (char)('0' + value % 10);
+			value /= 10;
+		}
+	}
+	for (int i = 0; i < HUD_ATTEMPT_DIGITS; i++)
+	{
+		if (attemptOnScreen[i] != digits[i])
+		{
+			attemptOnScreen[i] = digits[i];
+			printChar(digits[i], HUD_ATTEMPT_X + i * HUD_CHAR_ADVANCE, RGBToWord(0xff, 0xff, 0xff));
+		}
+	}
+}
+
+static int markerColumn(void)
+{
+	return best * (HUD_BAR_WIDTH - 1) / 100;
+}
+static void drawMarker(void)
+{
+	markerOnScreen = (uint8_t)markerColumn();
+	fillRectangle((uint16_t)(HUD_BAR_X + markerOnScreen), HUD_BAR_Y - 1, 1, HUD_BAR_HEIGHT + 2, RGBToWord(0xff, 0xff, 0x00));
+}
+
+static void updateBest(void)
+{
+	// Right aligned, blanks before
+	uint8_t value = best;
+	for (int i = HUD_BEST_DIGITS - 1; i >= 0; i--)
+	{
+		char c = (char)('0' + value % 10);
+		if (value == 0 && i < HUD_BEST_DIGITS - 1) c = ' ';
+		value /= 10;
+		if (bestOnScreen[i] != c)
+		{
+			bestOnScreen[i] = c;
+			printChar(c, HUD_BEST_X + i * HUD_CHAR_ADVANCE, RGBToWord(0xff, 0xff, 0x00));
+		}
+	}
+	if (markerOnScreen != markerColumn())
+	{
+		// Put back the bar under the old marker, then the new one
+		if (markerOnScreen != HUD_NONE)
+		{
+			uint16_t x = (uint16_t)(HUD_BAR_X + markerOnScreen);
+			fillRectangle(x, HUD_BAR_Y - 1, 1, HUD_BAR_HEIGHT + 2, 0);
+			fillRectangle(x, HUD_BAR_Y, 1, HUD_BAR_HEIGHT,
+				markerOnScreen < barOnScreen ? RGBToWord(0x00, 0xff, 0x00) : RGBToWord(0x30, 0x30, 0x30));
+		}
+		drawMarker();
+	}
+}
+
+void hudDraw(void)
+{
+	fillRectangle(0, 0, SCREEN_WIDTH, HUD_HEIGHT, 0);
+	printChar('A', 1, RGBToWord(0x00, 0xcc, 0xff));
+	printChar('%', HUD_BEST_X + HUD_BEST_DIGITS * HUD_CHAR_ADVANCE, RGBToWord(0xff, 0xff, 0x00));
+	fillRectangle(HUD_BAR_X, HUD_BAR_Y, HUD_BAR_WIDTH, HUD_BAR_HEIGHT, RGBToWord(0x30, 0x30, 0x30));
+	for (int i = 0; i < HUD_ATTEMPT_DIGITS; i++)
+		attemptOnScreen[i] = 0;
+	for (int i = 0; i < HUD_BEST_DIGITS; i++)
+		bestOnScreen[i] = 0;
+	barOnScreen = 0;
+	markerOnScreen = HUD_NONE;
+	updateAttempt();
+	updateBest();
+}
+
+void hudSetAttempt(uint16_t n)
+{
+	attempt = n;
+	updateAttempt();
+}
+void hudSetBest(uint8_t percent)
+{
+	best = percent > 100 ? 100 : percent;
+	updateBest();
+}
+
+void hudFrame(const GameState *g)
+{
+	// Thinned when the governor is short of time, except where the run ends
+	if (!governorHudDue() && !g->dead && !g->won)
+		return;
+	uint8_t columns = (uint8_t)gameProgress(g, HUD_BAR_WIDTH);
+	if (columns == barOnScreen)
+		return;
+	int from = barOnScreen < columns ? barOnScreen : columns;
+	int to = barOnScreen < columns ? columns : barOnScreen;
+	// Filling on, or emptied for a new attempt
+	fillRectangle((uint16_t)(HUD_BAR_X + from), HUD_BAR_Y, (uint16_t)(to - from), HUD_BAR_HEIGHT,
+		columns > barOnScreen ? RGBToWord(0x00, 0xff, 0x00) : RGBToWord(0x30, 0x30, 0x30));
+	barOnScreen = columns;
+	if (markerOnScreen >= from && markerOnScreen < to)
+		drawMarker();
+}
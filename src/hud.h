@@ -0,0 +1,28 @@
+#ifndef HUD_H
+#define HUD_H
+#include <stdint.h>
+#include "game.h"
+
+// ============================================
+// HUD
+// The strip above the playfield (HUD_HEIGHT rows, which the playfield
+// renderer and the effects never draw on) shows
+//
+//   A<attempt>  [progress bar | best marker]  <best>%
+//
+// The bar follows gameProgress, the marker sits at the best percentage
+// reached on this level.  Like the debug overlay, only what changed since
+// the last frame is sent: the newly filled (or, on a new attempt, cleared)
+// bar columns and the digits that differ.
+// ============================================
+// Repaint the whole strip from the current values.  Call after anything
+// else has painted over it.
+void hudDraw(void);
+void hudSetAttempt(uint16_t attempt);
+void hudSetBest(uint8_t percent);
+// Bring the bar up to date with the run.  Under QUALITY_LAZY_HUD this
+// only happens every 4th frame (the bar catches up then), and on the frame
+// the run ends.
+void hudFrame(const GameState *g);
+
+#endif
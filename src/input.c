@@ -0,0 +1,217 @@
+#include "input.h"
+#include "timebase.h"
+#include "profiler.h"
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+
+void EXTI4_15_IRQHandler(void);
+
+typedef struct {
+	GPIO_TypeDef *port;
+	uint8_t pin;     // also the EXTI line
+	uint8_t portSel; // SYSCFG EXTICR value: 0 = port A, 1 = port B
+} ButtonPin;
+
+static const ButtonPin buttonPins[INPUT_BUTTONS] = {
+	{ GPIOA, 8, 0 },
+	{ GPIOA, 11, 0 },
+	{ GPIOA, 12, 0 },
+	{ GPIOB, 4, 1 },
+	{ GPIOB, 5, 1 },
+};
+#define INPUT_EXTI_LINES ((1u << 4) | (1u << 5) | (1u << 8) | (1u << 11) | (1u << 12))
+#endif
+
+static InputEvent queue[INPUT_QUEUE_SIZE];
+static volatile uint8_t queueHead, queueTail; // head: interrupt side, tail: inputPoll
+
+// Interrupt side state
+static volatile uint8_t reported[INPUT_BUTTONS];  // last state pushed to the queue
+static volatile uint32_t lastEdge[INPUT_BUTTONS]; // when that happened
+
+// Main loop side state
+static uint8_t held;
+static uint8_t pressedLatch;
+static uint32_t jumpPressTime;
+static uint8_t jumpPressValid;
+static uint32_t jumpBufferUs = INPUT_JUMP_BUFFER_US;
+static uint32_t photonStart;
+static uint8_t photonPending;
+static InputLatency latency;
+
+static void push(uint8_t button, uint8_t pressed, uint32_t time)
+{
+	uint8_t next = (uint8_t)((queueHead + 1) & (INPUT_QUEUE_SIZE - 1));
+	if (next == queueTail)
+		return; // full: drop, the level check in inputPoll will resync
+	queue[queueHead].time = time;
+	queue[queueHead].button = button;
+	queue[queueHead].pressed = pressed;
+	queueHead = next;
+}
+
+#ifndef HOST_BUILD
+static uint8_t pinDown(int i)
+{
+	return (uint8_t)((buttonPins[i].port->IDR & (1u << buttonPins[i].pin)) == 0);
+}
+static void pinSetup(const ButtonPin *b)
+{
+	uint32_t pin = b->pin;
+	b->port->MODER &= ~(3u << (pin * 2));         // input
+	b->port->PUPDR &= ~(3u << (pin * 2));
+	b->port->PUPDR |= (1u << (pin * 2));          // pull-up, buttons pull to ground
+	SYSCFG->EXTICR[pin >> 2] &= ~(0xfu << ((pin & 3) * 4));
+	SYSCFG->EXTICR[pin >> 2] |= ((uint32_t)b->portSel << ((pin & 3) * 4));
+}
+void inputInit(void)
+{
+	RCC->AHBENR |= (1 << 18) | (1 << 17); // enable Ports A and B
+	RCC->APB2ENR |= (1 << 0);             // SYSCFG, for the EXTI port selection
+	for (int i = 0; i < INPUT_BUTTONS; i++)
+		pinSetup(&buttonPins[i]);
+	uint32_t now = micros();
+	for (int i = 0; i < INPUT_BUTTONS; i++)
+	{
+		reported[i] = pinDown(i);
+		lastEdge[i] = now;
+		if (reported[i]) held |= (uint8_t)(1 << i);
+	}
+	EXTI->RTSR |= INPUT_EXTI_LINES;  // both edges
+	EXTI->FTSR |= INPUT_EXTI_LINES;
+	EXTI->PR = INPUT_EXTI_LINES;
+	EXTI->IMR |= INPUT_EXTI_LINES;
+	NVIC_EnableIRQ(EXTI4_15_IRQn);
+}
+void EXTI4_15_IRQHandler(void)
+{
+	uint32_t pending = EXTI->PR & INPUT_EXTI_LINES;
+	EXTI->PR = pending; // write 1 to clear
+	uint32_t now = micros();
+	for (int i = 0; i < INPUT_BUTTONS; i++)
+	{
+		if (!(pending & (1u << buttonPins[i].pin)))
+			continue;
+		if (now - lastEdge[i] < INPUT_DEBOUNCE_US)
+			continue; // contact bounce; inputPoll settles the final level
+		uint8_t down = pinDown(i);
+		if (down == reported[i])
+			continue;
+		reported[i] = down;
+		lastEdge[i] = now;
+		push((uint8_t)i, down, now);
+	}
+}
+#else
+void inputInit(void)
+{
+	queueHead = queueTail = 0;
+	held = 0;
+	pressedLatch = 0;
+	jumpPressValid = 0;
+	for (int i = 0; i < INPUT_BUTTONS; i++)
+		reported[i] = 0;
+}
+void inputInject(uint8_t button, uint8_t pressed, uint32_t time)
+{
+	reported[button] = pressed;
+	lastEdge[button] = time;
+	push(button, pressed, time);
+}
+#endif
+
+void inputPoll(void)
+{
+#ifndef HOST_BUILD
+	// Close out expired debounce windows where the pin ended up somewhere else
+	uint32_t now = micros();
+	for (int i = 0; i < INPUT_BUTTONS; i++)
+	{
+		__asm(" cpsid i ");
+		if (now - lastEdge[i] >= INPUT_DEBOUNCE_US)
+		{
+			uint8_t down = pinDown(i);
+			if (down != reported[i])
+			{
+				reported[i] = down;
+				lastEdge[i] = now;
+				push((uint8_t)i, down, now);
+			}
+		}
+		__asm(" cpsie i ");
+	}
+#endif
+	while (queueTail != queueHead)
+	{
+		const InputEvent *ev = &queue[queueTail];
+		uint8_t bit = (uint8_t)(1 << ev->button);
+		if (ev->pressed)
+		{
+			held |= bit;
+			pressedLatch |= bit;
+			if (bit & INPUT_JUMP)
+			{
+				jumpPressTime = ev->time;
+				jumpPressValid = 1;
+			}
+		}
+		else
+		{
+			held &= (uint8_t)~bit;
+		}
+		queueTail = (uint8_t)((queueTail + 1) & (INPUT_QUEUE_SIZE - 1));
+	}
+}
+uint8_t inputHeld(void)
+{
+	return held;
+}
+uint8_t inputPressed(uint8_t mask)
+{
+	uint8_t hit = pressedLatch & mask;
+	pressedLatch &= (uint8_t)~mask;
+	return hit;
+}
+void inputClearPressed(void)
+{
+	pressedLatch = 0;
+	jumpPressValid = 0;
+}
+int inputJumpBuffered(uint32_t now)
+{
+	if (jumpPressValid && (now - jumpPressTime) > jumpBufferUs)
+		jumpPressValid = 0; // too old to count
+	return jumpPressValid;
+}
+void inputJumpTaken(void)
+{
+	if (jumpPressValid)
+	{
+		photonStart = jumpPressTime;
+		photonPending = 1;
+	}
+	jumpPressValid = 0;
+}
+void inputSetJumpBuffer(uint32_t us)
+{
+	jumpBufferUs = us;
+}
+void inputPhoton(uint32_t now)
+{
+	if (!photonPending)
+		return;
+	photonPending = 0;
+	uint32_t us = now - photonStart;
+	latency.last = us;
+	if (us > latency.max) latency.max = us;
+	latency.total += us;
+	latency.count++;
+#if PROFILER_ENABLED
+	profilerRecordTicks(PROF_LATENCY, us * PROFILER_TICKS_PER_US);
+#endif
+}
+const InputLatency *inputLatency(void)
+{
+	return &latency;
+}
@@ -0,0 +1,75 @@
+#ifndef INPUT_H
+#define INPUT_H
+#include <stdint.h>
+
+// ============================================
+// BUTTON INPUT
+// Every button edge raises an EXTI interrupt, which timestamps it with
+// micros() and pushes it onto a small single-producer/single-consumer queue.
+// inputPoll() drains the queue once per loop, so the game sees the real
+// press time rather than the time the loop got round to reading IDR.
+//
+// Debounce: the first edge is accepted immediately (no added latency), then
+// that button ignores edges for INPUT_DEBOUNCE_US.  When the window ends
+// inputPoll() compares the pin against the reported state and emits a
+// catch-up event if they differ, so a short tap is never lost.
+// ============================================
+enum {
+	BTN_LEFT,   // PA8
+	BTN_RIGHT,  // PA11
+	BTN_PAUSE,  // PA12
+	BTN_UP,     // PB4
+	BTN_DOWN,   // PB5
+	INPUT_BUTTONS
+};
+#define INPUT_LEFT  (1 << BTN_LEFT)
+#define INPUT_RIGHT (1 << BTN_RIGHT)
+#define INPUT_PAUSE (1 << BTN_PAUSE)
+#define INPUT_UP    (1 << BTN_UP)
+#define INPUT_DOWN  (1 << BTN_DOWN)
+#define INPUT_ANY   ((1 << INPUT_BUTTONS) - 1)
+#define INPUT_JUMP  (INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN)
+
+#define INPUT_DEBOUNCE_US 5000u
+#define INPUT_QUEUE_SIZE 16 // must be a power of 2
+// A jump press this recent still counts when the player lands
+#ifndef INPUT_JUMP_BUFFER_US
+#define INPUT_JUMP_BUFFER_US 100000u
+#endif
+
+typedef struct {
+	uint32_t time;   // micros() at the edge
+	uint8_t button;  // BTN_*
+	uint8_t pressed; // 1 = pressed, 0 = released
+} InputEvent;
+
+typedef struct {
+	uint32_t last, max; // microseconds from press to the player blit that showed the jump
+	uint32_t total, count;
+} InputLatency;
+
+void inputInit(void);
+// Drain the event queue and finish any debounce windows that have expired
+void inputPoll(void);
+// Debounced state of every button (INPUT_* mask)
+uint8_t inputHeld(void);
+// Buttons in mask pressed since the last call; clears those latches
+uint8_t inputPressed(uint8_t mask);
+void inputClearPressed(void);
+
+// Jump buffer: is there an unused jump press within the buffer window?
+int inputJumpBuffered(uint32_t now);
+// Mark the buffered press (if any) as used and start a latency measurement
+// from its timestamp.  Jumps from simply holding a button aren't measured.
+void inputJumpTaken(void);
+void inputSetJumpBuffer(uint32_t us);
+// Call right after the frame's player blit has gone out on the bus
+void inputPhoton(uint32_t now);
+const InputLatency *inputLatency(void);
+
+#ifdef HOST_BUILD
+// Host builds have no pins; feed edges in as if from the interrupt
+void inputInject(uint8_t button, uint8_t pressed, uint32_t time);
+#endif
+
+#endif
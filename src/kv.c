@@ -0,0 +1,338 @@
+#include "kv.h"
+#include "flash.h"
+#include "crc.h"
+
+#define KV_MAGIC 0x564b // "KV"
+// magic, sequence number, its complement
+#define KV_HEADER_BYTES 6
+#define KV_RECORD_HEADER 4
+
+enum { REC_END, REC_LOST, REC_DAMAGED, REC_VALID };
+enum { KV_IDLE, KV_ERASE, KV_COPY, KV_FLUSH, KV_COMMIT };
+
+typedef struct {
+	uint8_t key;
+	uint8_t len;
+	uint8_t written; // already copied into the page being compacted into
+	uint8_t value[KV_MAX_VALUE];
+} Pending;
+
+static Pending pending[KV_PENDING];
+static uint8_t numPending;
+// Pages are numbered round the ring, 0..FLASH_KV_PAGES-1
+static int8_t activePage = -1; // -1 until the first page is written
+static uint16_t activeSeq;
+static uint16_t appendAt;      // where the next record goes
+static uint8_t mustCompact;    // a damaged record: nothing more goes after it
+static uint8_t state;
+static int8_t targetPage;      // being compacted into
+static uint16_t copyFrom, copyTo;
+
+static const uint8_t *page(int r)
+{
+	return flashPage(FLASH_KV_FIRST + r);
+}
+static uint16_t get16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint16_t recordCrc(uint8_t key, uint8_t len, const uint8_t *value)
+{
+	uint8_t head[2] = { key, len };
+	uint16_t crc = crc16(crc16(0xffff, head, 2), value, len);
+	// All ones is what an unwritten CRC reads as
+	return crc == 0xffff ? 0 : crc;
+}
+static uint16_t recordSize(uint8_t len)
+{
+	return (uint16_t)(KV_RECORD_HEADER + ((len + 1) & ~1));
+}
+static uint16_t programCost(uint16_t bytes)
+{
+	return (uint16_t)((bytes + 1) / 2 * FLASH_PROGRAM_US);
+}
+
+// What's at offset in a page.  REC_LOST is a record whose length can't be
+// right, so there's no stepping over it to the next.
+static int readRecord(const uint8_t *p, uint16_t offset)
+{
+	if (offset + KV_RECORD_HEADER > FLASH_PAGE_BYTES || get16(p + offset) == 0xffff)
+		return REC_END;
+	uint8_t len = p[offset + 1];
+	if (len > KV_MAX_VALUE || offset + recordSize(len) > FLASH_PAGE_BYTES)
+		return REC_LOST;
+	return get16(p + offset + 2) == recordCrc(p[offset], len, p + offset + KV_RECORD_HEADER) ? REC_VALID : REC_DAMAGED;
+}
+// Offset of key's newest good record in page r at or after from; 0 if none
+static uint16_t findNewest(int r, uint8_t key, uint16_t from)
+{
+	const uint8_t *p = page(r);
+	uint16_t found = 0;
+	int rec;
+	for (uint16_t at = from; (rec = readRecord(p, at)) >= REC_DAMAGED; at = (uint16_t)(at + recordSize(p[at + 1])))
+	{
+		if (rec == REC_VALID && p[at] == key)
+			found = at;
+	}
+	return found;
+}
+// The record goes in head first and CRC last, so one cut short never
+// carries a CRC that matches
+static int writeRecord(int r, uint16_t at, uint8_t key, uint8_t len, const uint8_t *value)
+{
+	uint8_t rec[KV_RECORD_HEADER + KV_MAX_VALUE];
+	uint16_t size = recordSize(len);
+	uint16_t crc = recordCrc(key, len, value);
+	rec[0] = key;
+	rec[1] = len;
+	rec[2] = (uint8_t)crc;
+	rec[3] = (uint8_t)(crc >> 8);
+	for (int i = 0; i < size - KV_RECORD_HEADER; i++)
+		rec[KV_RECORD_HEADER + i] = i < len ? value[i] : 0xff;
+	int pg = FLASH_KV_FIRST + r;
+	return flashProgram(pg, at, rec, 2) && flashProgram(pg, (uint16_t)(at + KV_RECORD_HEADER), rec + KV_RECORD_HEADER,
+		(uint16_t)(size - KV_RECORD_HEADER)) && flashProgram(pg, (uint16_t)(at + 2), rec + 2, 2);
+}
+
+static Pending *findPending(uint8_t key)
+{
+	for (int i = 0; i < numPending; i++)
+	{
+		if (pending[i].key == key)
+			return &pending[i];
+	}
+	return 0;
+}
+static void dropPending(int i)
+{
+	pending[i] = pending[--numPending];
+}
+// Start compacting over again, from the erase
+static void restartCompaction(void)
+{
+	for (int i = 0; i < numPending; i++)
+		pending[i].written = 0;
+	state = KV_ERASE;
+}
+
+void kvInit(void)
+{
+	numPending = 0;
+	state = KV_IDLE;
+	activePage = -1;
+	mustCompact = 0;
+	for (int r = 0; r < FLASH_KV_PAGES; r++)
+	{
+		const uint8_t *p = page(r);
+		uint16_t seq = get16(p + 2), check = (uint16_t)~seq;
+		if (get16(p) == KV_MAGIC && get16(p + 4) == check && (activePage < 0 || (int16_t)(seq - activeSeq) > 0))
+		{
+			activePage = (int8_t)r;
+			activeSeq = seq;
+		}
+	}
+	if (activePage < 0)
+		return; // blank: the first kvService makes a page
+	const uint8_t *p = page(activePage);
+	uint16_t at = KV_HEADER_BYTES;
+	int rec;
+	while ((rec = readRecord(p, at)) >= REC_DAMAGED)
+	{
+		if (rec == REC_DAMAGED)
+			mustCompact = 1;
+		at = (uint16_t)(at + recordSize(p[at + 1]));
+	}
+	if (rec == REC_LOST)
+		mustCompact = 1;
+	appendAt = at;
+}
+
+int kvGet(uint8_t key, void *value, uint8_t len)
+{
+	const uint8_t *src = 0;
+	uint8_t found = 0;
+	Pending *q = findPending(key);
+	if (q)
+	{
+		src = q->value;
+		found = q->len;
+	}
+	else if (activePage >= 0)
+	{
+		uint16_t at = findNewest(activePage, key, KV_HEADER_BYTES);
+		if (at)
+		{
+			src = page(activePage) + at + KV_RECORD_HEADER;
+			found = page(activePage)[at + 1];
+		}
+	}
+	if (!src || found != len)
+		return 0;
+	for (int i = 0; i < len; i++)
+		((uint8_t *)value)[i] = src[i];
+	return 1;
+}
+
+int kvSet(uint8_t key, const void *value, uint8_t len)
+{
+	uint8_t now[KV_MAX_VALUE];
+	const uint8_t *v = value;
+	if (len > KV_MAX_VALUE || key == 0xff)
+		return 0;
+	if (kvGet(key, now, len))
+	{
+		int same = 1;
+		for (int i = 0; i < len; i++)
+			same &= now[i] == v[i];
+		if (same)
+			return 1;
+	}
+	Pending *q = findPending(key);
+	if (!q)
+	{
+		if (numPending == KV_PENDING)
+			return 0;
+		q = &pending[numPending++];
+		q->key = key;
+	}
+	q->len = len;
+	q->written = 0;
+	for (int i = 0; i < len; i++)
+		q->value[i] = v[i];
+	return 1;
+}
+
+int kvService(uint32_t budgetUs)
+{
+	for (;;)
+	{
+		const uint8_t *p = page(activePage < 0 ? 0 : activePage);
+		uint16_t cost;
+		switch (state)
+		{
+			case KV_IDLE:
+				if (!numPending)
+					return 0;
+				if (activePage < 0 || mustCompact || appendAt + recordSize(pending[0].len) > FLASH_PAGE_BYTES)
+				{
+					state = KV_ERASE;
+					break;
+				}
+				cost = programCost(recordSize(pending[0].len));
+				if (cost > budgetUs)
+					return 1;
+				budgetUs -= cost;
+				if (!writeRecord(activePage, appendAt, pending[0].key, pending[0].len, pending[0].value))
+				{
+					// Whatever got written there is damaged: go round it
+					mustCompact = 1;
+					break;
+				}
+				appendAt = (uint16_t)(appendAt + recordSize(pending[0].len));
+				dropPending(0);
+				break;
+
+			case KV_ERASE:
+				if (budgetUs < FLASH_ERASE_US)
+					return 1;
+				budgetUs -= FLASH_ERASE_US;
+				targetPage = (int8_t)(activePage < 0 ? 0 : (activePage + 1) % FLASH_KV_PAGES);
+				if (!flashErasePage(FLASH_KV_FIRST + targetPage))
+					return 1; // try again next time
+				copyFrom = copyTo = KV_HEADER_BYTES;
+				state = activePage < 0 ? KV_FLUSH : KV_COPY;
+				break;
+
+			case KV_COPY:
+			{
+				// The newest good record of each key comes across, unless
+				// there's a newer value waiting to be written anyway
+				int rec = readRecord(p, copyFrom);
+				if (rec < REC_DAMAGED)
+				{
+					state = KV_FLUSH;
+					break;
+				}
+				uint8_t key = p[copyFrom], len = p[copyFrom + 1];
+				uint16_t size = recordSize(len);
+				if (rec == REC_VALID && !findPending(key) && findNewest(activePage, key, copyFrom) == copyFrom
+					&& copyTo + size <= FLASH_PAGE_BYTES)
+				{
+					cost = programCost(size);
+					if (cost > budgetUs)
+						return 1;
+					budgetUs -= cost;
+					if (!writeRecord(targetPage, copyTo, key, len, p + copyFrom + KV_RECORD_HEADER))
+					{
+						restartCompaction();
+						break;
+					}
+					copyTo = (uint16_t)(copyTo + size);
+				}
+				copyFrom = (uint16_t)(copyFrom + size);
+				break;
+			}
+
+			case KV_FLUSH:
+			{
+				// Then what's queued, which stays queued (and is what kvGet
+				// sees) until the new page is the current one
+				Pending *q = 0;
+				for (int i = 0; i < numPending && !q; i++)
+				{
+					if (!pending[i].written && copyTo + recordSize(pending[i].len) <= FLASH_PAGE_BYTES)
+						q = &pending[i];
+				}
+				if (!q)
+				{
+					state = KV_COMMIT;
+					break;
+				}
+				cost = programCost(recordSize(q->len));
+				if (cost > budgetUs)
+					return 1;
+				budgetUs -= cost;
+				if (!writeRecord(targetPage, copyTo, q->key, q->len, q->value))
+				{
+					restartCompaction();
+					break;
+				}
+				q->written = 1;
+				copyTo = (uint16_t)(copyTo + recordSize(q->len));
+				break;
+			}
+
+			default: // KV_COMMIT
+			{
+				cost = programCost(KV_HEADER_BYTES);
+				if (cost > budgetUs)
+					return 1;
+				budgetUs -= cost;
+				uint16_t seq = (uint16_t)(activePage < 0 ? 0 : activeSeq + 1);
+				uint16_t check = (uint16_t)~seq;
+				uint8_t header[KV_HEADER_BYTES] = {
+					(uint8_t)KV_MAGIC, (uint8_t)(KV_MAGIC >> 8), (uint8_t)seq, (uint8_t)(seq >> 8), (uint8_t)check, (uint8_t)(check >> 8)
+				};
+				// Magic last, so the page isn't current until it's all there
+				int pg = FLASH_KV_FIRST + targetPage;
+				if (!flashProgram(pg, 2, header + 2, KV_HEADER_BYTES - 2) || !flashProgram(pg, 0, header, 2))
+				{
+					restartCompaction();
+					break;
+				}
+				activePage = targetPage;
+				activeSeq = seq;
+				appendAt = copyTo;
+				mustCompact = 0;
+				for (int i = numPending - 1; i >= 0; i--)
+				{
+					if (pending[i].written)
+						dropPending(i);
+				}
+				state = KV_IDLE;
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,59 @@
+#ifndef KV_H
+#define KV_H
+#include <stdint.h>
+
+// ============================================
+// KEY-VALUE STORE
+// Small values kept across resets, in the flash pages reserved for them
+// (flash.h).  The store is a log: setting a key appends a record
+//
+//   0   u8   key
+//   1   u8   value length
+//   2   u16  CRC-16 (CCITT) of bytes 0, 1 and the value
+//   4        value, padded with 0xff to a halfword
+//
+// and a key's value is its newest record with a good CRC.  Nothing is
+// rewritten in place.  When the page fills up, the newest record of each
+// key is copied into the next page round, and that page's header, written
+// last, makes it the current one.  The pages take turns, so they wear
+// evenly.  A header is a magic number, a sequence number and its
+// complement: a half-written or half-erased one never looks valid.  A
+// record cut short by a reset fails its CRC.  Either way the previous
+// value is what comes back.
+//
+// kvSet doesn't touch flash.  It queues the value in RAM, where kvGet sees
+// it straight away.  kvService writes the queue out a bounded slice at a
+// time and is only called from the menu, so an erase never lands in the
+// middle of a frame.  What's still queued at a reset is lost.
+// ============================================
+#define KV_MAX_VALUE 4  // bytes
+// Keys that can be waiting for kvService at once.  Each costs
+// KV_MAX_VALUE + 3 bytes of static RAM, which comes out of what's left for
+// the stack, so this is the most the game queues rather than a round
+// number: a run sets a level's attempts and best, and a win the level
+// (kvService only runs on the menu); the menu then adds the character and
+// an upload's attempts and best before the queue has drained.
+#define KV_PENDING 6
+
+// Keys are stored in flash: add new ones, never renumber.  Values are
+// little endian.
+enum {
+	KV_LEVEL = 1,       // u8, level picked on the menu
+	KV_CHARACTER,       // u8, character picked on character select
+	KV_BEST_0 = 16,     // u8 per level from here on: furthest reached, percent
+	KV_ATTEMPTS_0 = 48  // u16 per level from here on: attempts started
+};
+
+// Find the current page.  Call flashInit first.
+void kvInit(void);
+// 1 if key has a value of exactly len bytes, copied into value
+int kvGet(uint8_t key, void *value, uint8_t len);
+// Queue a value; a value the key already has queues nothing.  0 if it's
+// too long or the queue is full.
+int kvSet(uint8_t key, const void *value, uint8_t len);
+// Write out what's queued, stopping before the flash operations would take
+// longer than budgetUs at worst.  An erase needs FLASH_ERASE_US (flash.h)
+// in one go.  Returns 1 while there's more to do.
+int kvService(uint32_t budgetUs);
+
+#endif
@@ -0,0 +1,17 @@
+#include "levels.h"
+
+// Level data comes from the images in assets/levels/ (tools/asset_compiler.py)
+#include "levels/level_data.h"
+
+#if LEVEL_COUNT != NUM_LEVELS
+#error "NUM_LEVELS in levels.h doesn't match the images in assets/levels/"
+#endif
+
+const LevelInfo levels[NUM_LEVELS] = { LEVEL_TABLE };
+LevelInfo uploadedLevel;
+int numLevels = NUM_LEVELS;
+
+const LevelInfo *levelInfo(int level)
+{
+	return level == LEVEL_UPLOADED ? &uploadedLevel : &levels[level];
+}
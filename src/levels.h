@@ -0,0 +1,37 @@
+#ifndef LEVELS_H
+#define LEVELS_H
+#include <stdint.h>
+
+// ============================================
+// LEVEL SYSTEM
+// Levels stored in separate .h files, pulled in by levels.c
+// 0 = empty, 1 = kill triangle, 2 = platform block, 3 = jump pad
+// ============================================
+#define LEVEL_ROWS 4
+#define NUM_LEVELS 3  // built in
+// After the built-in levels, the one uploaded over serial (upload.h)
+#define LEVEL_UPLOADED NUM_LEVELS
+#define LEVEL_SLOTS (NUM_LEVELS + 1)
+
+#define TILE_EMPTY 0
+#define TILE_SPIKE 1
+#define TILE_BLOCK 2
+#define TILE_PAD 3
+
+// Level table: each entry has row pointers and length
+typedef struct {
+	const uint8_t *rows[LEVEL_ROWS]; // pointer to each row
+	int length;                       // number of columns
+} LevelInfo;
+
+extern const LevelInfo levels[NUM_LEVELS];
+// LEVEL_UPLOADED's entry, filled in at run time (upload.c)
+extern LevelInfo uploadedLevel;
+// Levels there are to play: the built-in ones, and LEVEL_UPLOADED once
+// there is an uploaded one
+extern int numLevels;
+
+// Entry for any level number, LEVEL_UPLOADED included
+const LevelInfo *levelInfo(int level);
+
+#endif
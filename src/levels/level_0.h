@@ -1,64 +0,0 @@
-#ifndef LEVEL_0_H
-#define LEVEL_0_H
-
-#include <stdint.h>
-
-#define LEVEL_0_LENGTH 60
-#define LEVEL_0_ROWS 4
-
-const uint8_t level_0_data[LEVEL_0_ROWS][LEVEL_0_LENGTH] = {
-        // Row 0 (ground level)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 1, 2, 1, 2, 1,
-                2, 1, 2, 0, 2, 0,
-                2, 0, 0, 0, 0, 0,
-                1, 2, 0, 0, 1, 2,
-                0, 0, 1, 2, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 1, 0, 0, 0, 1,
-                0, 0, 0, 1, 0, 0,
-        },
-        // Row 1 (1 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 2, 0,
-                2, 0, 2, 0, 2, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 2, 0,
-                2, 2, 0, 2, 2, 0,
-                2, 2, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-        },
-        // Row 2 (2 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                2, 0, 2, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-        },
-        // Row 3 (3 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0, 
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-        },
-};
-
-#endif
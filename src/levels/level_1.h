@@ -1,80 +0,0 @@
-#ifndef LEVEL_1_H
-#define LEVEL_1_H
-
-#include <stdint.h>
-
-#define LEVEL_1_LENGTH 80
-#define LEVEL_1_ROWS 4
-
-const uint8_t level_1_data[LEVEL_1_ROWS][LEVEL_1_LENGTH] = {
-        // Row 0 (ground level)
-        {
-                0, 0, 0, 1, 2, 2, 
-                1, 0, 0, 2, 0, 2, 
-                1, 1, 1, 1, 1, 1, 
-                1, 1, 1, 1, 0, 0, 
-                0, 0, 0, 0, 0, 1, 
-                0, 0, 0, 2, 0, 0, 
-                0, 0, 3, 0, 0, 0, 
-                0, 0, 0, 0, 0, 0, 
-                0, 0, 0, 0, 0, 0, 
-                0, 0, 0, 1, 0, 0,
-                0, 2, 0, 0, 2, 2,
-                2, 2, 2, 2, 2, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0,
-        },
-        // Row 1 (1 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 2,
-                0, 0, 0, 2, 0, 0,
-                0, 2, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 2, 0, 0,
-                0, 0, 0, 0, 2, 2,
-                2, 2, 2, 2, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 2, 0, 0,
-                1, 0, 0, 1, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0,
-        },
-        // Row 2 (2 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 2, 0, 0, 0, 2,
-                0, 0, 0, 2, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 2, 0,
-                2, 2, 2, 0, 0, 0,
-                1, 0, 0, 1, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0,
-        },
-        // Row 3 (3 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0, 
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0,
-        },
-};
-
-#endif
@@ -1,92 +0,0 @@
-#ifndef LEVEL_2_H
-#define LEVEL_2_H
-
-#include <stdint.h>
-
-#define LEVEL_2_LENGTH 100
-#define LEVEL_2_ROWS 4
-
-const uint8_t level_2_data[LEVEL_2_ROWS][LEVEL_2_LENGTH] = {
-                // Row 0 (ground level)
-        {
-                0, 0, 0, 1, 0, 0,
-                0, 0, 2, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 1,
-                0, 0, 1, 0, 0, 1,
-                0, 0, 0, 3, 1, 1,
-                0, 0, 0, 0, 2, 1,
-                1, 1, 1, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 2, 2, 2, 2, 
-                0, 0, 0, 0, 3, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                1, 0, 0, 3, 0, 0,
-                3, 0, 0, 0, 
-        },
-        // Row 1 (1 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 2, 0,
-                0, 0, 0, 2, 2, 2,
-                2, 2, 2, 2, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                2, 0, 0, 2, 2, 0,
-                0, 2, 2, 0, 2, 2,
-                0, 0, 0, 2, 2, 2,
-                2, 2, 0, 0, 0, 1,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0,
-        },
-        // Row 2 (2 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                2, 2, 2, 2, 0, 0,
-                0, 1, 0, 3, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 2, 0, 0, 0,
-                0, 0, 0, 0, 0, 3,
-                0, 0, 0, 0, 0, 0,
-                0, 1, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 2,
-                2, 2, 2, 0, 0, 2,
-                2, 2, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0,
-        },
-        // Row 3 (3 block(s) above ground)
-        {
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 1, 0, 0,
-                0, 0, 0, 0, 0, 2,
-                2, 0, 0, 0, 0, 2,
-                0, 0, 2, 0, 0, 2,
-                0, 0, 0, 0, 0, 0, 
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 2, 2, 2, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 1, 0, 0, 0, 0,
-                0, 0, 0, 0, 0, 0,
-                0, 0, 0, 0,
-        },
-};
-
-#endif
@@ -0,0 +1,79 @@
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+// Generated by tools/asset_compiler.py from assets/levels/; edit the images, not this file.
+// Included by levels.c only.
+
+#include <stdint.h>
+
+// Every level row lives in levelTiles; identical rows, and runs shared
+// between the end of one row and the start of the next, are stored once.
+#define LEVEL_COUNT 3
+#define LEVEL_TILES 800
+
+#define LEVEL_0_LENGTH 60
+#define LEVEL_0_INFO { { levelTiles + 634, levelTiles + 692, levelTiles + 740, levelTiles + 561 }, LEVEL_0_LENGTH }
+#define LEVEL_1_LENGTH 80
+#define LEVEL_1_INFO { { levelTiles + 368, levelTiles + 439, levelTiles + 509, levelTiles + 561 }, LEVEL_1_LENGTH }
+#define LEVEL_2_LENGTH 100
+#define LEVEL_2_INFO { { levelTiles + 0, levelTiles + 97, levelTiles + 185, levelTiles + 271 }, LEVEL_2_LENGTH }
+#define LEVEL_TABLE LEVEL_0_INFO, LEVEL_1_INFO, LEVEL_2_INFO
+
+const uint8_t levelTiles[LEVEL_TILES] = {
+	// level 2 row 0
+	0,0,0,1,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,1,0,0,1,0,0,1,0,0,0,3,
+	1,1,0,0,0,0,2,1,1,1,1,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,3,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,1,0,0,3,0,0,3,
+	// level 2 row 1
+	0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,2,2,2,2,2,
+	2,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,2,0,0,2,2,0,0,2,2,0,2,2,
+	0,0,0,2,2,2,2,2,0,0,0,1,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,
+	// level 2 row 2
+	0,0,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,1,
+	0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,3,
+	0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,2,2,2,
+	2,0,0,2,2,2,
+	// level 2 row 3
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,
+	0,0,0,2,2,0,0,0,0,2,0,0,2,0,0,2,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,2,2,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,
+	// level 1 row 0
+	0,0,0,1,2,2,1,0,0,2,0,2,1,1,1,1,1,1,1,1,
+	1,1,0,0,0,0,0,0,0,1,0,0,0,2,0,0,0,0,3,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,
+	0,2,0,0,2,2,2,2,2,2,2,
+	// level 1 row 1
+	0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,2,0,0,0,2,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,
+	0,0,0,0,0,0,2,2,2,2,2,2,0,0,0,0,0,0,0,0,
+	0,0,0,2,0,0,1,0,0,1,
+	// level 1 row 2
+	0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,2,0,0,
+	0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	2,0,2,2,2,0,0,0,1,0,0,1,
+	// level 0 row 3, level 1 row 3
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,
+	// level 0 row 0
+	0,0,0,0,0,0,0,1,2,1,2,1,2,1,2,0,2,0,2,0,
+	0,0,0,0,1,2,0,0,1,2,0,0,1,2,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,1,0,0,0,1,0,0,0,1,
+	// level 0 row 1
+	0,0,0,0,0,0,0,0,0,0,2,0,2,0,2,0,2,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,2,2,0,2,
+	2,0,2,2,0,0,0,0,
+	// level 0 row 2
+	0,0,0,0,0,0,0,0,0,0,0,0,2,0,2,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "overlay.h"
+#include "display.h"
+#include "game.h"
+
+#define OVERLAY_CHAR_ADVANCE 7 // printText: 5 pixel glyph + 2 pixel gap
+#define OVERLAY_ROW_PITCH 8    // 7 pixel glyph + 1, two rows fill the band
+#define OVERLAY_MAX_DIGITS 5
+
+enum { FIELD_FRAME, FIELD_TICKS, FIELD_BUS, FIELD_STACK, OVERLAY_FIELDS };
+
+typedef struct {
+	char label;
+	uint8_t col, row;  // label position in characters
+	uint8_t digits;
+} OverlayField;
+
+static const OverlayField fields[OVERLAY_FIELDS] = {
+	{ 'F', 0, 0, 5 },
+	{ 'T', 7, 0, 1 },
+	{ 'B', 0, 1, 5 },
+	{ 'S', 7, 1, 4 },
+};
+
+static int shown;
+_Static_assert(2 * OVERLAY_ROW_PITCH < FLOOR_LEVEL_Y, "overlay rows don't fit in the floor band");
+// What is on the panel now; 0 means unknown, so the next frame sends it
+static char onScreen[OVERLAY_FIELDS][OVERLAY_MAX_DIGITS];
+
+static uint16_t fieldX(const OverlayField *f, int i)
+{
+	return (uint16_t)(2 + (f->col + i) * OVERLAY_CHAR_ADVANCE);
+}
+static uint16_t fieldY(const OverlayField *f)
+{
+	return (uint16_t)(FLOOR_TOP + 1 + f->row * OVERLAY_ROW_PITCH);
+}
+
+void overlayShow(int on)
+{
+	shown = on;
+	overlayDraw();
+}
+int overlayShown(void)
+{
+	return shown;
+}
+void overlayDraw(void)
+{
+	fillRectangle(0, FLOOR_TOP, SCREEN_WIDTH, FLOOR_LEVEL_Y, FLOOR_COLOUR);
+	for (int f = 0; f < OVERLAY_FIELDS; f++)
+		for (int i = 0; i < OVERLAY_MAX_DIGITS; i++)
+			onScreen[f][i] = 0;
+	if (!shown)
+		return;
+	uint16_t labelColour = RGBToWord(0xff, 0xff, 0x00);
+	for (int f = 0; f < OVERLAY_FIELDS; f++)
+	{
+		char text[2] = { fields[f].label, 0 };
+		printText(text, fieldX(&fields[f], 0), fieldY(&fields[f]), labelColour, FLOOR_COLOUR);
+	}
+}
+
+static void updateField(int f, uint32_t value)
+{
+	const OverlayField *field = &fields[f];
+	uint16_t colour = RGBToWord(0xff, 0xff, 0xff);
+	char text[2] = { 0, 0 };
+	// Right aligned, pinned at all nines when it doesn't fit
+	for (int i = field->digits - 1; i >= 0; i--)
+	{
+		char c = (char)('0' + value % 10);
+		if (value == 0 && i < field->digits - 1) c = ' ';
+		value /= 10;
+		text[0] = c;
+		if (onScreen[f][i] != c)
+		{
+			onScreen[f][i] = c;
+			printText(text, fieldX(field, 1 + i), fieldY(field), colour, FLOOR_COLOUR);
+		}
+	}
+}
+void overlayFrame(const OverlayStats *s)
+{
+	if (!shown)
+		return;
+	updateField(FIELD_FRAME, s->frameTime > 99999u ? 99999u : s->frameTime);
+	updateField(FIELD_TICKS, s->ticks > 9 ? 9 : s->ticks);
+	updateField(FIELD_BUS, s->busBytes > 99999u ? 99999u : s->busBytes);
+	updateField(FIELD_STACK, s->freeStack > 9999u ? 9999u : s->freeStack);
+}
@@ -0,0 +1,31 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+#include <stdint.h>
+
+// ============================================
+// DEBUG OVERLAY
+// Live numbers printed in the floor band during play, two rows of
+//
+//   F<frame us>  T<ticks run>
+//   B<bus bytes> S<free stack>
+//
+// Toggled with RIGHT on the pause screen.  Only the digits that changed
+// since the last frame are sent to the panel, so leaving it on costs a
+// handful of 5x7 glyphs per frame rather than the whole band (and under
+// QUALITY_LAZY_HUD the governor thins the updates further).
+// ============================================
+typedef struct {
+	uint32_t frameTime;  // microseconds since the previous frame started
+	uint32_t busBytes;   // panel bus traffic of the previous frame
+	uint32_t freeStack;  // stack never touched since reset, bytes
+	uint8_t ticks;       // simulation ticks run this frame
+} OverlayStats;
+
+void overlayShow(int on);
+int overlayShown(void);
+// Repaint the floor band, and the overlay over it if shown.  Call after
+// anything else has painted the band.
+void overlayDraw(void);
+void overlayFrame(const OverlayStats *s);
+
+#endif
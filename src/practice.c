@@ -0,0 +1,78 @@
+#include "practice.h"
+#include "arena.h"
+#include "effects.h"
+
+#define TURNS_IN_AIR 0x8000
+
+_Static_assert(sizeof(Checkpoint) == 32, "checkpoint snapshot has grown");
+
+void practiceReset(void)
+{
+	arena.mode.play.practice.count = 0;
+}
+
+void practiceSave(const GameState *g)
+{
+	PracticeRing *r = &arena.mode.play.practice;
+	r->newest = (uint8_t)((r->newest + 1) % PRACTICE_CHECKPOINTS);
+	if (r->count < PRACTICE_CHECKPOINTS)
+		r->count++;
+	Checkpoint *c = &r->ring[r->newest];
+	c->jumpHeight = g->jumpHeight;
+	c->currentVelocity = g->currentVelocity;
+	c->scrollOffset = g->scrollOffset;
+	c->tick = g->tick;
+	c->rng = effectsRandState();
+	c->turns = (uint16_t)((g->rotation & ~TURNS_IN_AIR) | (g->isInAir ? TURNS_IN_AIR : 0));
+	c->turnLeft = (int16_t)(g->targetRotAngle - g->rotAngle);
+}
+
+int practiceDrop(void)
+{
+	PracticeRing *r = &arena.mode.play.practice;
+	if (!r->count)
+		return 0;
+	r->newest = (uint8_t)((r->newest + PRACTICE_CHECKPOINTS - 1) % PRACTICE_CHECKPOINTS);
+	r->count--;
+	return 1;
+}
+
+int practiceCount(void)
+{
+	return arena.mode.play.practice.count;
+}
+
+static void load(const Checkpoint *c, GameState *g, const LevelInfo *level)
+{
+	gameReset(g, level);
+	g->jumpHeight = c->jumpHeight;
+	g->currentVelocity = c->currentVelocity;
+	g->scrollOffset = c->scrollOffset;
+	g->tick = c->tick;
+	g->isInAir = (c->turns & TURNS_IN_AIR) != 0;
+	g->rotation = c->turns & ~TURNS_IN_AIR;
+	g->targetRotAngle = g->rotation * 90;
+	g->rotAngle = g->targetRotAngle - c->turnLeft;
+	// as gameStep leaves it
+	g->drawY = (uint16_t)(GROUND_Y - (int)g->jumpHeight);
+}
+
+int practiceRestore(GameState *g, const LevelInfo *level)
+{
+	PracticeRing *r = &arena.mode.play.practice;
+	if (!r->count)
+		return 0;
+	load(&r->ring[r->newest], g, level);
+	effectsSeed(r->ring[r->newest].rng);
+	return 1;
+}
+
+int practiceProgress(const LevelInfo *level, int scale)
+{
+	PracticeRing *r = &arena.mode.play.practice;
+	GameState g;
+	if (!r->count)
+		return 0;
+	load(&r->ring[r->newest], &g, level);
+	return gameProgress(&g, scale);
+}
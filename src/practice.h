@@ -0,0 +1,55 @@
+#ifndef PRACTICE_H
+#define PRACTICE_H
+#include <stdint.h>
+#include "game.h"
+
+// ============================================
+// PRACTICE CHECKPOINTS
+// In practice mode the player drops checkpoints along the way, and a death
+// goes back to the newest one instead of the start of the level.  A
+// checkpoint is a fixed-size snapshot of everything gameStep carries from
+// one tick to the next (what gameReset would otherwise set), plus the
+// effects RNG, so play from a checkpoint goes exactly as it did from the
+// same point first time round.  drawY and the target angle are worked out
+// again on the way back, and dead and won are always clear.  (Pads have no
+// state to keep: one fires on every tick the player overlaps it.)
+//
+// The newest PRACTICE_CHECKPOINTS are kept, oldest dropped first.  They
+// live in the shared prefix of the RAM arena's game overlays (arena.h), so
+// they last through a death but not a trip to the menu: start each run
+// with practiceReset, after arenaEnter(ARENA_PLAY).
+// ============================================
+#define PRACTICE_CHECKPOINTS 4
+
+typedef struct {
+	double jumpHeight;
+	double currentVelocity;
+	float scrollOffset;
+	uint32_t tick;
+	uint32_t rng;       // effects RNG
+	// Quarter turns started, modulo 32768 (a whole number of full turns,
+	// so angles come out the same), with isInAir in the top bit
+	uint16_t turns;
+	int16_t turnLeft;   // degrees rotAngle is still to turn
+} Checkpoint;
+
+typedef struct {
+	Checkpoint ring[PRACTICE_CHECKPOINTS];
+	uint8_t newest; // index in ring
+	uint8_t count;
+} PracticeRing;
+
+// Forget every checkpoint (a new run)
+void practiceReset(void);
+// Drop a checkpoint where g is now
+void practiceSave(const GameState *g);
+// Forget the newest checkpoint; 0 if there wasn't one
+int practiceDrop(void);
+int practiceCount(void);
+// Put g (and the effects RNG) back at the newest checkpoint; 0 if there
+// isn't one, leaving g as it was
+int practiceRestore(GameState *g, const LevelInfo *level);
+// gameProgress at the newest checkpoint, 0 if there isn't one
+int practiceProgress(const LevelInfo *level, int scale);
+
+#endif
@@ -0,0 +1,125 @@
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+#include "display.h"
+
+static ProfStats profStats[PROF_SECTIONS];
+static const char *const profNames[PROF_SECTIONS] = {
+	"FRAME", "PHYS", "COLL", "TILE", "PORT", "PART", "ROT", "BLIT", "LAT"
+};
+
+void profilerInit(void)
+{
+#ifndef HOST_BUILD
+	SysTick->LOAD = 0xffffff; // full 24 bit range
+	SysTick->VAL = 0;
+	SysTick->CTRL = 5;        // processor clock, enabled, no interrupt
+#endif
+	profilerReset();
+}
+void profilerReset(void)
+{
+	for (int i = 0; i < PROF_SECTIONS; i++)
+	{
+		profStats[i].min = 0xffffffffu;
+		profStats[i].max = 0;
+		profStats[i].total = 0;
+		profStats[i].count = 0;
+	}
+}
+void profilerRecord(ProfSection section, uint32_t start)
+{
+#ifndef HOST_BUILD
+	uint32_t ticks = (start - profilerNow()) & 0xffffff; // SysTick counts down
+#else
+	uint32_t ticks = profilerNow() - start;
+#endif
+	profilerRecordTicks(section, ticks);
+}
+void profilerRecordTicks(ProfSection section, uint32_t ticks)
+{
+	ProfStats *s = &profStats[section];
+	if (ticks < s->min) s->min = ticks;
+	if (ticks > s->max) s->max = ticks;
+	s->total += ticks;
+	s->count++;
+}
+const ProfStats *profilerStats(ProfSection section)
+{
+	return &profStats[section];
+}
+const char *profilerName(ProfSection section)
+{
+	return profNames[section];
+}
+
+static uint16_t toMicros(uint64_t ticks)
+{
+	ticks /= PROFILER_TICKS_PER_US;
+	return (ticks > 65535) ? 65535 : (uint16_t)ticks;
+}
+void profilerDrawScreen(uint16_t y)
+{
+	uint16_t fg = RGBToWord(0xff, 0xff, 0xff);
+	uint16_t hdr = RGBToWord(0xff, 0xff, 0x00);
+	fillRectangle(0, y, SCREEN_WIDTH, (PROF_SECTIONS + 1) * 10, 0);
+	// Three 5 digit columns only fit the wide profiles, so narrow ones drop MIN
+	printText("US", 2, y, hdr, 0);
+#if SCREEN_WIDTH >= 160
+	printText("MIN", SCREEN_WIDTH - 116, y, hdr, 0);
+#endif
+	printText("AVG", SCREEN_WIDTH - 78, y, hdr, 0);
+	printText("MAX", SCREEN_WIDTH - 40, y, hdr, 0);
+	for (int i = 0; i < PROF_SECTIONS; i++)
+	{
+		const ProfStats *s = &profStats[i];
+		uint16_t rowY = (uint16_t)(y + 10 * (i + 1));
+		printText(profNames[i], 2, rowY, fg, 0);
+		if (s->count == 0) continue;
+#if SCREEN_WIDTH >= 160
+		printNumber(toMicros(s->min), SCREEN_WIDTH - 120, rowY, fg, 0);
+#endif
+		printNumber(toMicros(s->total / s->count), SCREEN_WIDTH - 82, rowY, fg, 0);
+		printNumber(toMicros(s->max), SCREEN_WIDTH - 44, rowY, fg, 0);
+	}
+}
+
+// Right aligned unsigned decimal into a fixed width field
+static char *putField(char *p, uint32_t value, int width)
+{
+	for (int i = width - 1; i >= 0; i--)
+	{
+		p[i] = (char)('0' + value % 10);
+		value /= 10;
+		if (value == 0)
+		{
+			while (i > 0) p[--i] = ' ';
+			break;
+		}
+	}
+	return p + width;
+}
+void profilerReport(void (*writeLine)(const char *line))
+{
+	char line[48];
+	writeLine("section     count   min_us   avg_us   max_us\r\n");
+	for (int i = 0; i < PROF_SECTIONS; i++)
+	{
+		const ProfStats *s = &profStats[i];
+		char *p = line;
+		const char *n = profNames[i];
+		int len = 0;
+		while (n[len]) { *p++ = n[len]; len++; }
+		while (len++ < 6) *p++ = ' ';
+		uint32_t avg = s->count ? (uint32_t)(s->total / s->count) : 0;
+		p = putField(p, s->count, 9);
+		p = putField(p, s->count ? s->min / PROFILER_TICKS_PER_US : 0, 9);
+		p = putField(p, avg / PROFILER_TICKS_PER_US, 9);
+		p = putField(p, s->max / PROFILER_TICKS_PER_US, 9);
+		*p++ = '\r';
+		*p++ = '\n';
+		*p = 0;
+		writeLine(line);
+	}
+}
+#endif
@@ -0,0 +1,86 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+#include <stdint.h>
+
+// ============================================
+// HOT PATH PROFILER
+// Cortex-M0 has no DWT cycle counter, so SysTick is left free running over
+// its full 24 bits with no interrupt and read as a down counting cycle counter
+// (wraps every ~350ms at 48MHz, far longer than any one section).
+// Build with -DPROFILER_ENABLED=1 to turn it on; otherwise every marker
+// compiles to nothing.
+//
+//     PROFILE_BEGIN(PROF_TILES);
+//     ... work ...
+//     PROFILE_END(PROF_TILES);
+//
+// Sections may nest (PROF_FRAME covers the whole frame, PROF_PHYSICS
+// includes PROF_COLLISION), each one just records its own elapsed time.
+// ============================================
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+typedef enum {
+	PROF_FRAME,      // whole gameplay frame, excluding the frame delay
+	PROF_PHYSICS,    // jump, gravity and landing
+	PROF_COLLISION,  // platform landing / standing scans
+	PROF_TILES,      // visible tile draw and hazard checks
+	PROF_PORTAL,     // procedural portal ellipse and particle spawn
+	PROF_PARTICLES,  // portal particle update
+	PROF_ROTATION,   // sprite rotation while airborne
+	PROF_PLAYER,     // player erase strip and blit
+	PROF_LATENCY,    // jump press to the player blit showing it (recorded by input.c)
+	PROF_SECTIONS
+} ProfSection;
+
+#if PROFILER_ENABLED
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+#define PROFILER_TICKS_PER_US 48
+static inline uint32_t profilerNow(void)
+{
+	return SysTick->VAL;
+}
+#else
+#include "timebase.h"
+#define PROFILER_TICKS_PER_US 1
+static inline uint32_t profilerNow(void)
+{
+	return micros();
+}
+#endif
+
+#define PROFILE_BEGIN(sec) uint32_t profStart_##sec = profilerNow()
+#define PROFILE_END(sec) profilerRecord(sec, profStart_##sec)
+
+typedef struct {
+	uint32_t min, max;  // ticks
+	uint64_t total;
+	uint32_t count;
+} ProfStats;
+
+void profilerInit(void);
+void profilerReset(void);
+void profilerRecord(ProfSection section, uint32_t start);
+void profilerRecordTicks(ProfSection section, uint32_t ticks);
+const ProfStats *profilerStats(ProfSection section);
+const char *profilerName(ProfSection section);
+// Print the table (microseconds) over the top of the playfield
+void profilerDrawScreen(uint16_t y);
+// Emit the table one text line at a time, e.g. to the serial port
+void profilerReport(void (*writeLine)(const char *line));
+
+#else
+
+#define PROFILE_BEGIN(sec) (void)0
+#define PROFILE_END(sec) (void)0
+#define profilerInit() (void)0
+#define profilerReset() (void)0
+#define profilerDrawScreen(y) (void)0
+#define profilerReport(writeLine) (void)0
+
+#endif
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef RAMFUNC_H
+#define RAMFUNC_H
+
+// ============================================
+// RAM-RESIDENT FUNCTIONS
+// At 48 MHz the flash needs a wait state, so a tight loop fetching from
+// flash stalls on every other instruction fetch the prefetcher can't hide.
+// Marking a function RAMFUNC (on its prototype and its definition) puts it
+// in the .ramfunc section, which stm32f031x6_ramfunc.ld places inside .data:
+// the startup code's .data copy brings it into SRAM before main runs.
+//
+// RAM is the scarcer resource here, so only the pixel streaming loops are
+// marked.  What they call per pixel is static inline rather than RAMFUNC:
+// inlined, it runs from RAM with them, where RAMFUNC's noinline would make
+// it a long call on every pixel.  Every byte moved costs stack headroom;
+// check with tools/size_budget.py and tools/stack_report.py.
+//
+// Needs the custom linker script, so it is only on in env
+// nucleo_f031k6_speed (-DRAMFUNC_ENABLED=1).  long_call because a bl from
+// flash at 0x08000000 can't reach 0x20000000.
+// ============================================
+#if defined(RAMFUNC_ENABLED) && RAMFUNC_ENABLED && !defined(HOST_BUILD)
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define RAMFUNC
+#endif
+
+#endif
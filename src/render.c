@@ -0,0 +1,163 @@
+#include "render.h"
+#include "display.h"
+#include "arena.h"
+#include "effects.h"
+#include "governor.h"
+#include "overlay.h"
+#include "profiler.h"
+#include "sprite_map.h"
+
+static const uint16_t *character;
+static uint16_t oldDrawY = GROUND_Y;
+static int spriteAngle; // angle arena.mode.play.sprite was last rotated to
+
+void renderSetCharacter(const uint16_t *sprite)
+{
+	character = sprite;
+}
+void renderResetSprite(void)
+{
+	spriteAngle = 0;
+	computeSmoothRotatedSprite(character, arena.mode.play.sprite, MAIN_CHARACTER_SPRITE_SIZE_X, 0);
+}
+void renderPlayfield(void)
+{
+	fillRectangle(0, PLAYFIELD_TOP, SCREEN_WIDTH, FLOOR_TOP - PLAYFIELD_TOP, 0);
+	overlayDraw();
+	oldDrawY = GROUND_Y;
+}
+
+void renderScene(const GameState *g)
+{
+	uint16_t drawY = g->drawY;
+
+	// Only erase character if it moved vertically
+	PROFILE_BEGIN(PROF_PLAYER);
+	if (drawY != oldDrawY)
+	{
+		int eraseX = PLAYER_X - ROT_PAD;
+		int floorTop = FLOOR_TOP;
+		if (drawY > oldDrawY)
+		{
+			int ey = (int)oldDrawY - ROT_PAD;
+			int strip = drawY - oldDrawY;
+			if (strip > ROT_SIZE) strip = ROT_SIZE;
+			if (ey + strip > floorTop) strip = floorTop - ey;
+			if (ey < PLAYFIELD_TOP) { strip -= PLAYFIELD_TOP - ey; ey = PLAYFIELD_TOP; }
+			if (strip > 0)
+				fillRectangle((uint16_t)eraseX, (uint16_t)ey, ROT_SIZE, (uint16_t)strip, 0);
+		}
+		else
+		{
+			int strip = oldDrawY - drawY;
+			if (strip > ROT_SIZE) strip = ROT_SIZE;
+			int ey = (int)oldDrawY - ROT_PAD + ROT_SIZE - strip;
+			if (ey + strip > floorTop) strip = floorTop - ey;
+			if (ey < PLAYFIELD_TOP) { strip -= PLAYFIELD_TOP - ey; ey = PLAYFIELD_TOP; }
+			if (strip > 0)
+				fillRectangle((uint16_t)eraseX, (uint16_t)ey, ROT_SIZE, (uint16_t)strip, 0);
+		}
+	}
+	PROFILE_END(PROF_PLAYER);
+
+	// Draw visible obstacles from level data (collision is done in gameStep)
+	PROFILE_BEGIN(PROF_TILES);
+	const LevelInfo *level = g->level;
+	int scrollInt = (int)g->scrollOffset;
+	int pixelOffset = ((scrollInt % OBSTACLE_SIZE) + OBSTACLE_SIZE) % OBSTACLE_SIZE;
+	int firstTile = (scrollInt - pixelOffset) / OBSTACLE_SIZE;
+	for (int row = 0; row < ROWS_VISIBLE; row++)
+	{
+		int rowY = FLOOR_TOP - (row + 1) * OBSTACLE_SIZE;
+		for (int i = 0; i < TILES_ACROSS; i++)
+		{
+			int screenX = i * OBSTACLE_SIZE - pixelOffset;
+			if (screenX >= 0 && screenX + OBSTACLE_SIZE <= SCREEN_WIDTH)
+			{
+				int tileIdx = firstTile + i;
+				if (tileIdx < 0 || tileIdx >= level->length) continue;
+				uint8_t tile = level->rows[row][tileIdx];
+				if (tile == TILE_SPIKE)
+				{
+					putImage((uint16_t)screenX, (uint16_t)rowY, OBSTACLE_SIZE, OBSTACLE_SIZE, triangle1, 0, 0);
+				}
+				else if (tile == TILE_BLOCK)
+				{
+					putImage((uint16_t)screenX, (uint16_t)rowY, OBSTACLE_SIZE, OBSTACLE_SIZE, block1, 0, 0);
+				}
+				else if (tile == TILE_PAD)
+				{
+					putImage((uint16_t)screenX, (uint16_t)rowY, OBSTACLE_SIZE, OBSTACLE_SIZE, jumpPad, 0, 0);
+				}
+				else
+				{
+					// Empty tile — only clear if NOT overlapping the character
+					if (!(screenX < PLAYER_X + MAIN_CHARACTER_SPRITE_SIZE_X &&
+					      screenX + OBSTACLE_SIZE > PLAYER_X &&
+					      (int)drawY < rowY + OBSTACLE_SIZE &&
+					      (int)drawY + MAIN_CHARACTER_SPRITE_SIZE_Y > rowY))
+					{
+						fillRectangle((uint16_t)screenX, (uint16_t)rowY, OBSTACLE_SIZE, OBSTACLE_SIZE, 0);
+					}
+				}
+			}
+		}
+		// Clear partial strip at left edge for this row
+		if (pixelOffset > 0)
+			fillRectangle(0, (uint16_t)rowY, (uint16_t)pixelOffset, OBSTACLE_SIZE, 0);
+	}
+	PROFILE_END(PROF_TILES);
+}
+
+void renderPlayerAt(int x, int y)
+{
+	int h = ROT_SIZE;
+	const uint16_t *rows = arena.mode.play.sprite;
+	if (y + h > FLOOR_TOP) h = FLOOR_TOP - y;
+	if (y < PLAYFIELD_TOP)
+	{
+		// The rows above the playfield are the ones left out
+		rows += (PLAYFIELD_TOP - y) * ROT_SIZE;
+		h -= PLAYFIELD_TOP - y;
+		y = PLAYFIELD_TOP;
+	}
+	if (h > 0)
+		putImage((uint16_t)x, (uint16_t)y, ROT_SIZE, (uint16_t)h, rows, 0, 0);
+}
+
+void renderActors(const GameState *g)
+{
+	// The sprite only needs rotating again when the angle has moved (by
+	// a coarser step when the governor is short of time; the landing snap
+	// is always drawn)
+	int turned = g->rotAngle - spriteAngle;
+	if (turned < 0) turned = -turned;
+	if (turned >= governorRotationStep() || (turned != 0 && g->rotAngle == g->targetRotAngle))
+	{
+		PROFILE_BEGIN(PROF_ROTATION);
+		computeSmoothRotatedSprite(character, arena.mode.play.sprite, MAIN_CHARACTER_SPRITE_SIZE_X, g->rotAngle);
+		spriteAngle = g->rotAngle;
+		PROFILE_END(PROF_ROTATION);
+	}
+
+	// Draw exit portal procedurally + emit particles (before character).
+	// The pulse follows simulation time so a replay draws the same frames.
+	int portalScreenX = gamePortalScreenX(g);
+	int portalY = FLOOR_TOP - PORTAL_HEIGHT;
+	if (portalScreenX < SCREEN_WIDTH && portalScreenX + PORTAL_WIDTH > 0 && governorPortalDue())
+	{
+		PROFILE_BEGIN(PROF_PORTAL);
+		drawProceduralPortal(portalScreenX, portalY, PORTAL_PULSE(g->tick * GAME_TICK_US));
+		spawnPortalParticle(portalScreenX, portalY);
+		PROFILE_END(PROF_PORTAL);
+	}
+	PROFILE_BEGIN(PROF_PARTICLES);
+	updatePortalParticles();
+	PROFILE_END(PROF_PARTICLES);
+
+	// Draw character on top; always, since obstacles scroll behind it
+	PROFILE_BEGIN(PROF_PLAYER);
+	renderPlayerAt(PLAYER_X - ROT_PAD, (int)g->drawY - ROT_PAD);
+	oldDrawY = g->drawY;
+	PROFILE_END(PROF_PLAYER);
+}
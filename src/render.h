@@ -0,0 +1,31 @@
+#ifndef RENDER_H
+#define RENDER_H
+#include <stdint.h>
+#include "game.h"
+
+// ============================================
+// PLAYFIELD RENDERING
+// A gameplay frame is drawn in two halves so the caller can step in when
+// the attempt ends between them:
+//
+//   renderScene   erase the strip the player moved out of, draw the tiles
+//   renderActors  re-rotate the player sprite if needed, portal and its
+//                 sparks, then the player
+//
+// Only what changed is drawn, so a frame relies on the one before it.
+// The device loop and the host golden-frame check (src/host/golden_main.c)
+// draw through the same calls, so the check sees exactly what the panel
+// is sent.  The player sprite lives in the arena's play overlay.
+// ============================================
+void renderSetCharacter(const uint16_t *sprite);
+// Sprite back upright, for a new attempt
+void renderResetSprite(void);
+// Blank playfield and floor band; the player is drawn by the next frame
+void renderPlayfield(void);
+void renderScene(const GameState *g);
+void renderActors(const GameState *g);
+// The player sprite with its top left at x, y, clipped to the playfield
+// (rows cut off above the HUD or below the floor top are left out)
+void renderPlayerAt(int x, int y);
+
+#endif
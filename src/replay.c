@@ -0,0 +1,193 @@
+#include "replay.h"
+
+void replayBegin(Replay *r, uint8_t level, uint32_t seed)
+{
+	r->level = level;
+	r->truncated = 0;
+	r->state = 0;
+	r->length = 0;
+	r->seed = seed;
+	r->ticks = 0;
+	r->lastToggle = 0;
+}
+
+void replayRecord(Replay *r, int jump)
+{
+	if (r->truncated) return;
+	uint8_t state = jump ? 1 : 0;
+	if (state != r->state)
+	{
+		uint32_t delta = r->ticks - r->lastToggle;
+		uint8_t bytes[5];
+		uint16_t n = 0;
+		do {
+			bytes[n] = (uint8_t)(delta & 0x7f);
+			delta >>= 7;
+			if (delta) bytes[n] |= 0x80;
+			n++;
+		} while (delta);
+		if (r->length + n > REPLAY_BUFFER)
+		{
+			// Keep what fits; the recording is still exact up to here
+			r->truncated = 1;
+			return;
+		}
+		for (uint16_t i = 0; i < n; i++)
+			r->data[r->length++] = bytes[i];
+		r->lastToggle = r->ticks;
+		r->state = state;
+	}
+	r->ticks++;
+}
+
+// Next edge tick, or 0xffffffff once the data runs out
+static uint32_t readToggle(ReplayPlayer *p, uint32_t from)
+{
+	const Replay *r = p->replay;
+	uint32_t delta = 0;
+	int shift = 0;
+	while (p->pos < r->length && shift < 32)
+	{
+		uint8_t b = r->data[p->pos++];
+		delta |= (uint32_t)(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return from + delta;
+		shift += 7;
+	}
+	return 0xffffffffu;
+}
+
+void replayPlayStart(ReplayPlayer *p, const Replay *r)
+{
+	p->replay = r;
+	p->pos = 0;
+	p->state = 0;
+	p->tick = 0;
+	p->nextToggle = readToggle(p, 0);
+}
+
+int replayPlayNext(ReplayPlayer *p)
+{
+	if (p->tick == p->nextToggle)
+	{
+		p->state ^= 1;
+		p->nextToggle = readToggle(p, p->tick);
+	}
+	p->tick++;
+	return p->state;
+}
+
+int replayPlayDone(const ReplayPlayer *p)
+{
+	return p->tick >= p->replay->ticks;
+}
+
+uint32_t replayFastForward(const Replay *r, GameState *g)
+{
+	ReplayPlayer p;
+	gameReset(g, levelInfo(r->level));
+	replayPlayStart(&p, r);
+	while (!replayPlayDone(&p) && !g->dead && !g->won)
+		gameStep(g, replayPlayNext(&p));
+	return g->tick;
+}
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static char *putHex(char *p, uint32_t value, int digits)
+{
+	for (int i = digits - 1; i >= 0; i--)
+		*p++ = hexDigits[(value >> (i * 4)) & 0xf];
+	return p;
+}
+static char *putDecimal(char *p, uint32_t value)
+{
+	char tmp[10];
+	int n = 0;
+	do {
+		tmp[n++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+	while (n) *p++ = tmp[--n];
+	return p;
+}
+
+void replayWrite(const Replay *r, uint32_t hash, void (*writeLine)(const char *line))
+{
+	// Written in pieces so the buffer doesn't have to hold the whole line
+	char buf[40];
+	char *p = buf;
+	const char *tag = "REPLAY ";
+	while (*tag) *p++ = *tag++;
+	p = putDecimal(p, r->level);
+	*p++ = ' ';
+	p = putHex(p, r->seed, 8);
+	*p++ = ' ';
+	p = putDecimal(p, r->ticks);
+	*p++ = ' ';
+	p = putHex(p, hash, 8);
+	*p++ = ' ';
+	*p = 0;
+	writeLine(buf);
+	uint16_t i = 0;
+	do {
+		p = buf;
+		while (i < r->length && p < buf + sizeof(buf) - 5)
+			p = putHex(p, r->data[i++], 2);
+		if (i == r->length)
+		{
+			*p++ = '\r';
+			*p++ = '\n';
+		}
+		*p = 0;
+		writeLine(buf);
+	} while (i < r->length);
+}
+
+static int hexValue(char c)
+{
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+// Parse one space separated field; returns 0 if it is empty or has bad digits
+static int getNumber(const char **s, uint32_t *value, int base)
+{
+	const char *p = *s;
+	uint32_t v = 0;
+	int n = 0;
+	while (*p == ' ') p++;
+	while (*p && *p != ' ' && *p != '\r' && *p != '\n')
+	{
+		int d = hexValue(*p++);
+		if (d < 0 || d >= base) return 0;
+		v = v * (uint32_t)base + (uint32_t)d;
+		n++;
+	}
+	*s = p;
+	*value = v;
+	return n > 0;
+}
+
+int replayParse(Replay *r, uint32_t *hash, const char *line)
+{
+	const char *tag = "REPLAY";
+	uint32_t level, seed, ticks;
+	while (*tag)
+		if (*line++ != *tag++) return 0;
+	if (!getNumber(&line, &level, 10) || level >= NUM_LEVELS) return 0;
+	if (!getNumber(&line, &seed, 16)) return 0;
+	if (!getNumber(&line, &ticks, 10)) return 0;
+	if (!getNumber(&line, hash, 16)) return 0;
+	replayBegin(r, (uint8_t)level, seed);
+	r->ticks = ticks;
+	while (*line == ' ') line++;
+	while (hexValue(line[0]) >= 0 && hexValue(line[1]) >= 0)
+	{
+		if (r->length >= REPLAY_BUFFER) return 0;
+		r->data[r->length++] = (uint8_t)(hexValue(line[0]) * 16 + hexValue(line[1]));
+		line += 2;
+	}
+	return (*line == 0 || *line == '\r' || *line == '\n');
+}
@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include <stdint.h>
+#include "game.h"
+
+// ============================================
+// REPLAYS
+// An attempt is fully described by its level, the RNG seed and the tick
+// numbers at which the jump input changed.  Those ticks are stored as
+// LEB128 deltas (one byte each for gaps under 1.28 s), input starting
+// released at tick 0.  The seed only drives the particle effects; the
+// simulation itself has no randomness.
+// ============================================
+#define REPLAY_BUFFER 64
+
+typedef struct {
+	uint8_t level;
+	uint8_t truncated;   // ran out of buffer, ticks stops where it filled
+	uint8_t state;       // jump input as of the last recorded tick
+	uint16_t length;     // bytes used in data
+	uint32_t seed;
+	uint32_t ticks;      // ticks covered by the recording
+	uint32_t lastToggle; // tick of the most recent edge
+	uint8_t data[REPLAY_BUFFER];
+} Replay;
+
+typedef struct {
+	const Replay *replay;
+	uint16_t pos;
+	uint8_t state;
+	uint32_t tick;
+	uint32_t nextToggle;
+} ReplayPlayer;
+
+// Recording: one replayRecord per gameStep, with the same jump value
+void replayBegin(Replay *r, uint8_t level, uint32_t seed);
+void replayRecord(Replay *r, int jump);
+
+// Playback: replayPlayNext returns the jump input for the next tick
+void replayPlayStart(ReplayPlayer *p, const Replay *r);
+int replayPlayNext(ReplayPlayer *p);
+int replayPlayDone(const ReplayPlayer *p);
+
+// Headless fast-forward: simulate the whole recording without drawing
+// anything.  Leaves the final state in g and returns the ticks run.
+uint32_t replayFastForward(const Replay *r, GameState *g);
+
+// Text form, one line: "REPLAY <level> <seed> <ticks> <hash> <data>\r\n"
+// with seed, hash and data in hex.  hash is gameHash of the final state so
+// a reported run can be checked by replaying it.
+void replayWrite(const Replay *r, uint32_t hash, void (*writeLine)(const char *line));
+// Returns 0 if the line is not a well formed replay
+int replayParse(Replay *r, uint32_t *hash, const char *line);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+#include <stdint.h>
+
+// ============================================
+// SEQUENCES
+// Stackless coroutines for animations that used to block in delay().
+// A sequence is a function that takes its Sequence and the current time,
+// does one step's worth of drawing and returns SEQ_RUNNING, or SEQ_DONE at
+// the end.  The main loop calls it once per pass, so input keeps being
+// polled and other work carries on while it plays.
+//
+// The body goes between SEQ_BEGIN and SEQ_END and resumes after the last
+// SEQ_YIELD/SEQ_WAIT_US on the next call.  Locals don't survive a resume
+// (it's a switch on the line number), so loop counters go in s->i or in
+// statics.  Code above SEQ_BEGIN runs on every call.
+//
+// seqSkip() jumps to the sequence's SEQ_SKIP_POINT, where it should put
+// the screen in its final state, or straight to the end if it has none.
+// ============================================
+#define SEQ_RUNNING 0
+#define SEQ_DONE 1
+
+typedef struct {
+	uint16_t line;   // where to resume; 0 = from the top
+	uint16_t i;      // loop counter that survives a yield
+	uint32_t start;  // micros() when the sequence was started
+	uint32_t wakeAt; // SEQ_WAIT_US resumes once this time has passed
+} Sequence;
+
+#define SEQ_LINE_SKIP 1 // never a resume point: no function body starts on line 1
+
+static inline void seqStart(Sequence *s, uint32_t now)
+{
+	s->line = 0;
+	s->i = 0;
+	s->start = now;
+	s->wakeAt = now;
+}
+static inline void seqSkip(Sequence *s)
+{
+	s->line = SEQ_LINE_SKIP;
+}
+
+#define SEQ_BEGIN(s) switch ((s)->line) { case 0:
+#define SEQ_YIELD(s) do { (s)->line = __LINE__; return SEQ_RUNNING; case __LINE__:; } while (0)
+#define SEQ_WAIT_US(s, now, us) do { (s)->wakeAt = (now) + (us); (s)->line = __LINE__; case __LINE__: \
+	if ((int32_t)((now) - (s)->wakeAt) < 0) return SEQ_RUNNING; } while (0)
+#define SEQ_SKIP_POINT(s) case SEQ_LINE_SKIP:
+#define SEQ_END(s) } (s)->line = 0; return SEQ_DONE
+
+#endif
@@ -0,0 +1,146 @@
+#include "serial.h"
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+#include "timebase.h"
+
+void USART1_IRQHandler(void);
+
+static uint8_t txBuffer[SERIAL_TX_BUFFER];
+static uint8_t rxBuffer[SERIAL_RX_BUFFER];
+// Head is only written by the producer and tail only by the consumer, so the
+// two sides never need to lock each other out
+static volatile uint8_t txHead, txTail;
+static volatile uint8_t rxHead, rxTail;
+
+void serialInit(void)
+{
+	RCC->AHBENR |= (1 << 17);       // Turn on GPIO A
+	RCC->APB2ENR |= (1 << 14);      // Turn on USART1
+	// PA9 and PA10 to alternative function 1
+	GPIOA->MODER &= ~((3u << 18) | (3u << 20));
+	GPIOA->MODER |= ((2u << 18) | (2u << 20));
+	GPIOA->AFR[1] &= ~((0xfu << 4) | (0xfu << 8));
+	GPIOA->AFR[1] |= ((1u << 4) | (1u << 8));
+	GPIOA->PUPDR &= ~(3u << 20);
+	GPIOA->PUPDR |= (1u << 20);     // pull-up on RX so an unplugged line idles high
+
+	USART1->CR1 = 0;
+	USART1->CR2 = 0;
+	USART1->CR3 = (1 << 12);        // disable over-run errors
+	USART1->BRR = (TIMEBASE_CLOCK_HZ + SERIAL_BAUD / 2) / SERIAL_BAUD;
+	txHead = txTail = 0;
+	rxHead = rxTail = 0;
+	USART1->CR1 = (1 << 5) | (1 << 3) | (1 << 2); // RXNE interrupt, TX and RX enable
+	USART1->CR1 |= (1 << 0);        // enable
+	NVIC_EnableIRQ(USART1_IRQn);
+}
+void USART1_IRQHandler(void)
+{
+	uint32_t isr = USART1->ISR;
+	if (isr & (1 << 5))
+	{
+		uint8_t c = (uint8_t)USART1->RDR;
+		uint8_t next = (uint8_t)((rxHead + 1) & (SERIAL_RX_BUFFER - 1));
+		if (next != rxTail) // drop the byte if the buffer is full
+		{
+			rxBuffer[rxHead] = c;
+			rxHead = next;
+		}
+	}
+	if ((isr & (1 << 7)) && (USART1->CR1 & (1 << 7)))
+	{
+		if (txTail != txHead)
+		{
+			USART1->TDR = txBuffer[txTail];
+			txTail = (uint8_t)((txTail + 1) & (SERIAL_TX_BUFFER - 1));
+		}
+		else
+		{
+			USART1->CR1 &= ~(1u << 7); // nothing left, stop TXE interrupts
+		}
+	}
+}
+uint16_t serialTxFree(void)
+{
+	return (uint16_t)((txTail - txHead - 1) & (SERIAL_TX_BUFFER - 1));
+}
+int serialWrite(const uint8_t *data, uint16_t len)
+{
+	if (len > serialTxFree())
+		return 0;
+	uint8_t head = txHead;
+	while (len--)
+	{
+		txBuffer[head] = *data++;
+		head = (uint8_t)((head + 1) & (SERIAL_TX_BUFFER - 1));
+	}
+	txHead = head;
+	USART1->CR1 |= (1 << 7);   // TXE interrupt picks it up from here
+	return 1;
+}
+int serialRead(void)
+{
+	if (rxTail == rxHead)
+		return -1;
+	uint8_t c = rxBuffer[rxTail];
+	rxTail = (uint8_t)((rxTail + 1) & (SERIAL_RX_BUFFER - 1));
+	return c;
+}
+#else
+#include <unistd.h>
+#include <fcntl.h>
+
+int hostSerialFd = -1;
+
+void serialInit(void)
+{
+	if (hostSerialFd >= 0)
+		fcntl(hostSerialFd, F_SETFL, fcntl(hostSerialFd, F_GETFL) | O_NONBLOCK);
+}
+uint16_t serialTxFree(void)
+{
+	return SERIAL_TX_BUFFER - 1;
+}
+int serialWrite(const uint8_t *data, uint16_t len)
+{
+	if (hostSerialFd < 0)
+		return 1;
+	while (len)
+	{
+		ssize_t n = write(hostSerialFd, data, len);
+		if (n <= 0)
+			return 0;
+		data += n;
+		len = (uint16_t)(len - n);
+	}
+	return 1;
+}
+int serialRead(void)
+{
+	uint8_t c;
+	if (hostSerialFd < 0 || read(hostSerialFd, &c, 1) != 1)
+		return -1;
+	return c;
+}
+#endif
+
+void eputchar(char c)
+{
+	uint8_t b = (uint8_t)c;
+	while (!serialWrite(&b, 1)); // wait for room in the buffer
+}
+char egetchar()
+{
+	int c;
+	while ((c = serialRead()) < 0); // wait for character to arrive
+	return (char)c;
+}
+void eputs(const char *String)
+{
+	while(*String) // keep printing until a NULL is found
+	{
+		eputchar(*String);
+		String++;
+	}
+}
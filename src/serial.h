@@ -0,0 +1,38 @@
+#ifndef SERIAL_H
+#define SERIAL_H
+#include <stdint.h>
+
+// ============================================
+// USART1 SERIAL PORT
+// TX: PA9, RX: PA10 (AF1), 8N1.  PA2/PA15 (the Nucleo virtual COM port)
+// aren't usable because PA2 drives the green LED.
+// Transmit goes through a ring buffer drained by the USART1 interrupt, so
+// writers never wait on the line.  Receive is buffered the same way.
+// ============================================
+#ifndef SERIAL_BAUD
+#define SERIAL_BAUD 115200u
+#endif
+#define SERIAL_TX_BUFFER 128 // must be a power of 2
+#define SERIAL_RX_BUFFER 64  // must be a power of 2
+#if SERIAL_TX_BUFFER > 256 || SERIAL_RX_BUFFER > 256
+#error "Serial ring indices are 8 bit"
+#endif
+
+void serialInit(void);
+// Queue len bytes if they all fit; returns 0 (and queues nothing) if they don't
+int serialWrite(const uint8_t *data, uint16_t len);
+uint16_t serialTxFree(void);
+// Non-blocking read: returns -1 when nothing has arrived
+int serialRead(void);
+
+// Text helpers.  eputchar waits for room in the ring buffer (not for the line)
+void eputchar(char c);
+char egetchar(void);
+void eputs(const char *String);
+
+#ifdef HOST_BUILD
+// Host builds send and receive through this file descriptor (-1 = discard)
+extern int hostSerialFd;
+#endif
+
+#endif
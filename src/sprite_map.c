@@ -0,0 +1,121 @@
+// Generated by tools/asset_compiler.py from assets/sprites/; edit the images, not this file.
+#include "sprite_map.h"
+
+const uint16_t spritePixels[SPRITE_PIXELS] = {
+	// block1 (16x16)
+	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
+	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
+	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
+	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
+	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
+	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
+	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
+	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
+	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
+	// characterOne (16x16)
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469, 1469,    0,    0,    0, 1469, 1469, 1469, 1469,    0,    0,    0, 1469, 1469,    0,
+	    0, 1469, 1469,    0,65535,    0, 1469, 1469, 1469, 1469,    0,65535,    0, 1469, 1469,    0,
+	    0, 1469, 1469,    0,    0,    0, 1469, 1469, 1469, 1469,    0,    0,    0, 1469, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469,    0,    0,    0, 1469, 1469, 1469, 1469, 1469, 1469,    0,    0,    0, 1469,    0,
+	    0, 1469,    0,65535,    0,    0,    0,    0,    0,    0,    0,    0,65535,    0, 1469,    0,
+	    0, 1469,    0,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,    0, 1469,    0,
+	    0, 1469,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,    0,
+	    0, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469, 1469,
+	// characterThree (16x16)
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,    0,
+	    0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,    0,
+	    0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,    0,
+	    0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,    0,
+	    0,65287,57367,65287,57367,65287,57367,57367,57367,65287,57367,65287,57367,65287,57367,    0,
+	    0,57367,65287,57367,65287,57367,65535,65535,65535,57367,65287,57367,65287,57367,65287,    0,
+	    0,65287,57367,65287,57367,57367,65535,    0,65535,57367,57367,65287,57367,65287,57367,    0,
+	    0,57367,65287,57367,65287,57367,65535,65535,65535,57367,65287,57367,65287,57367,65287,    0,
+	    0,65287,57367,65287,57367,65287,57367,57367,57367,65287,57367,65287,57367,65287,57367,    0,
+	    0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,    0,
+	    0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,    0,    0,
+	    0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,    0,    0,    0,
+	    0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,    0,    0,    0,    0,
+	    0,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	// characterTwo (16x16)
+	    0, 8192, 8192,    0,    0,    0,    0,    0, 8192, 8192, 8192,    0,    0, 8192, 8192,    0,
+	 8192,16128,16128,16128,16128, 7936,16128,16128, 7936,16128,16128, 7936, 7936, 7936, 7936,    0,
+	 8192,47905,47905,47905,47905,39713, 7936,16128,16128,16128,47905,47905,39713,47905,47905,    0,
+	    0,47905, 1585, 9777, 9777,39713, 7936,16128,16128,16128,39713, 9777, 1585, 1585,39713, 8192,
+	 8192,47905,57343, 1585, 1585,39713,16128, 7936, 7936, 7936,39713, 1585, 9777,65535,39713,    0,
+	    0,39713, 1585, 9777, 9777,47905, 7936, 7936,16128,16128,39713, 1585, 9777, 1585,39713, 8192,
+	 8192,39713,47905,47905,39713,47905, 7936, 7936, 7936, 7936,47905,39713,39713,39713,39713, 8192,
+	 8192, 7936, 7936, 7936,16128,16128,16128, 7936, 7936, 7936, 7936, 7936, 7936,16128,16128,    0,
+	    0, 7936, 9777, 9777, 9777, 9777, 1585, 9777, 9777, 1585, 9777, 9777, 9777, 9777, 7936,    0,
+	 8192,16128, 1585,57343,65535,57343,57343,57343,65535,57343,57343,65535,65535, 1585, 7936,    0,
+	 8192, 7936, 9777, 9777,24829, 9777, 1585, 1585, 1585, 1585, 1585, 1585, 1585, 9777,16128,    0,
+	 8192,16128, 7936, 1585,16637, 9777, 7936, 7936, 7936, 7936, 7936,16128,16128, 7936,16128,    0,
+	    0, 7936, 7936, 1585,16637, 9777, 7936,16128, 7936, 7936,16128,16128, 7936,16128,16128, 8192,
+	 8192, 7936,16128, 9777, 1585, 9777,16128, 7936,16128, 7936, 7936,16128, 7936, 7936, 7936,    0,
+	 8192, 7936,16128,16128, 7936, 7936, 7936, 7936, 7936, 7936, 7936,16128, 7936, 7936, 7936,    0,
+	    0, 8192,    0,    0,    0, 8192, 8192,    0, 8192, 8192,    0,    0, 8192,    0,    0, 8192,
+	// jumpPad (16x16)
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,65248,65248,65248,65248,65248,65248,65248,65248,65248,65248,    0,    0,    0,
+	    0,    0,65440,65248,65248,65248,65248,65248,65248,65248,65248,65248,65248,65440,    0,    0,
+	    0,64896,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,64896,    0,
+	    0,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,
+	// mainChar (16x16)
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,    0,
+	    0,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,    0,
+	    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,
+	    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0,
+	    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0,
+	    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,
+	    0,64768,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64768,    0,
+	    0,64768,64768,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,64768,64768,    0,
+	    0,64768,64768,    0, 2047, 2047, 2047, 2047, 2047, 2047, 2047, 2047,    0,64768,64768,    0,
+	    0,64768,64768,    0, 2047, 2047, 2047, 2047, 2047, 2047, 2047, 2047,    0,64768,64768,    0,
+	    0,64768,64768,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,64768,64768,    0,
+	    0,64512,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64512,    0,
+	    0,64512,64512,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64512,64512,    0,
+	    0,64512,64512,64512,64512,64512,64768,64768,64768,64512,64512,64512,64512,64512,64512,
+	// triangle1 (16x16)
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,63488,63488,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,    0,63488,63488,    0,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,63488,63488,63488,63488,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,    0,63488,63488,63488,63488,    0,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,    0,
+	    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,
+	    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,
+	    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,
+	    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,
+	    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,
+	    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,
+	    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,
+	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+};
@@ -1,107 +1,47 @@
-#ifndef SPRITES_H
-#define SPRITES_H
-
-#include <stdint.h>
-
-// =====================
-// Main character (16x16)
-// =====================
-
-const uint16_t mainChar[] = {
-	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-	    0,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,65285,    0,
-	    0,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,    0,
-	    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,
-	    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0,
-	    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0, 2047, 2047,    0,64960,64960,    0,
-	    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,    0,    0,    0,64960,64960,    0,
-	    0,64768,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64960,64768,    0,
-	    0,64768,64768,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,64768,64768,    0,
-	    0,64768,64768,    0, 2047, 2047, 2047, 2047, 2047, 2047, 2047, 2047,    0,64768,64768,    0,
-	    0,64768,64768,    0, 2047, 2047, 2047, 2047, 2047, 2047, 2047, 2047,    0,64768,64768,    0,
-	    0,64768,64768,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,64768,64768,    0,
-	    0,64512,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64512,    0,
-	    0,64512,64512,64768,64768,64768,64768,64768,64768,64768,64768,64768,64768,64512,64512,    0,
-	    0,64512,64512,64512,64512,64512,64768,64768,64768,64512,64512,64512,64512,64512,64512,    0,
-	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-};
-
-const uint16_t characterOne[] = {
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,1469,0,0,0,1469,1469,1469,1469,0,0,0,1469,1469,0,0,1469,1469,0,65535,0,1469,1469,1469,1469,0,65535,0,1469,1469,0,0,1469,1469,0,0,0,1469,1469,1469,1469,0,0,0,1469,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,0,0,0,1469,1469,1469,1469,1469,1469,0,0,0,1469,0,0,1469,0,65535,0,0,0,0,0,0,0,0,65535,0,1469,0,0,1469,0,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,0,1469,0,0,1469,0,0,0,0,0,0,0,0,0,0,0,0,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,1469,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
-};
-
-const uint16_t characterTwo[] = {
-	0,8192,8192,0,0,0,0,0,8192,8192,8192,0,0,8192,8192,0,8192,16128,16128,16128,16128,7936,16128,16128,7936,16128,16128,7936,7936,7936,7936,0,8192,47905,47905,47905,47905,39713,7936,16128,16128,16128,47905,47905,39713,47905,47905,0,0,47905,1585,9777,9777,39713,7936,16128,16128,16128,39713,9777,1585,1585,39713,8192,8192,47905,57343,1585,1585,39713,16128,7936,7936,7936,39713,1585,9777,65535,39713,0,0,39713,1585,9777,9777,47905,7936,7936,16128,16128,39713,1585,9777,1585,39713,8192,8192,39713,47905,47905,39713,47905,7936,7936,7936,7936,47905,39713,39713,39713,39713,8192,8192,7936,7936,7936,16128,16128,16128,7936,7936,7936,7936,7936,7936,16128,16128,0,0,7936,9777,9777,9777,9777,1585,9777,9777,1585,9777,9777,9777,9777,7936,0,8192,16128,1585,57343,65535,57343,57343,57343,65535,57343,57343,65535,65535,1585,7936,0,8192,7936,9777,9777,24829,9777,1585,1585,1585,1585,1585,1585,1585,9777,16128,0,8192,16128,7936,1585,16637,9777,7936,7936,7936,7936,7936,16128,16128,7936,16128,0,0,7936,7936,1585,16637,9777,7936,16128,7936,7936,16128,16128,7936,16128,16128,8192,8192,7936,16128,9777,1585,9777,16128,7936,16128,7936,7936,16128,7936,7936,7936,0,8192,7936,16128,16128,7936,7936,7936,7936,7936,7936,7936,16128,7936,7936,7936,0,0,8192,0,0,0,8192,8192,0,8192,8192,0,0,8192,0,0,8192,
-};
-
-const uint16_t characterThree[] = {
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,0,0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,0,0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,0,0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,0,0,65287,57367,65287,57367,65287,57367,57367,57367,65287,57367,65287,57367,65287,57367,0,0,57367,65287,57367,65287,57367,65535,65535,65535,57367,65287,57367,65287,57367,65287,0,0,65287,57367,65287,57367,57367,65535,0,65535,57367,57367,65287,57367,65287,57367,0,0,57367,65287,57367,65287,57367,65535,65535,65535,57367,65287,57367,65287,57367,65287,0,0,65287,57367,65287,57367,65287,57367,57367,57367,65287,57367,65287,57367,65287,57367,0,0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,0,0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,0,0,0,57367,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,0,0,0,0,65287,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,0,0,0,0,0,57367,65287,57367,65287,57367,65287,57367,65287,57367,57367,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
-};
-
-
-// =====================
-// Kill triangle (16x16)
-// =====================
-
-const uint16_t triangle1[] = {
-	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,    0,    0,63488,63488,    0,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,    0,    0,63488,63488,    0,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,    0,63488,63488,63488,63488,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,    0,63488,63488,63488,63488,    0,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,    0,
-	    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,
-	    0,    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,    0,
-	    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,
-	    0,    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,    0,
-	    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,
-	    0,    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,    0,
-	    0,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,63488,    0,
-	    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-};
-
-// =====================
-// Platform block (16x16)
-// =====================
-
-const uint16_t block1[] = {
-	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
-	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
-	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
-	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
-	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,
-	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
-	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
-	52857,52857,52857,33808,33808,52857,52857,52857,52857,52857,52857,33808,33808,52857,52857,52857,
-	33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,33808,
-};
-
-const uint16_t jumpPad[] = {
-
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-	0,0,0,65248,65248,65248,65248,65248,65248,65248,65248,65248,65248,0,0,0,
-	0,0,65440,65248,65248,65248,65248,65248,65248,65248,65248,65248,65248,65440,0,0,
-	0,64896,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,65440,64896,
-	0,0,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,64896,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
-};
-
-#endif // SPRITES_H
+#ifndef SPRITES_H
+#define SPRITES_H
+// Generated by tools/asset_compiler.py from assets/sprites/; edit the images, not this file.
+
+#include <stdint.h>
+
+// Every sprite is RGB565 in the panel's byte order, row by row.  They
+// all live in spritePixels (sprite_map.c); identical sprites share words.
+#define SPRITE_PIXELS 1740
+extern const uint16_t spritePixels[SPRITE_PIXELS];
+
+#define SPRITE_BLOCK1_OFFSET 0
+#define SPRITE_BLOCK1_WIDTH 16
+#define SPRITE_BLOCK1_HEIGHT 16
+#define block1 (spritePixels + SPRITE_BLOCK1_OFFSET)
+
+#define SPRITE_CHARACTER_ONE_OFFSET 256
+#define SPRITE_CHARACTER_ONE_WIDTH 16
+#define SPRITE_CHARACTER_ONE_HEIGHT 16
+#define characterOne (spritePixels + SPRITE_CHARACTER_ONE_OFFSET)
+
+#define SPRITE_CHARACTER_THREE_OFFSET 495
+#define SPRITE_CHARACTER_THREE_WIDTH 16
+#define SPRITE_CHARACTER_THREE_HEIGHT 16
+#define characterThree (spritePixels + SPRITE_CHARACTER_THREE_OFFSET)
+
+#define SPRITE_CHARACTER_TWO_OFFSET 750
+#define SPRITE_CHARACTER_TWO_WIDTH 16
+#define SPRITE_CHARACTER_TWO_HEIGHT 16
+#define characterTwo (spritePixels + SPRITE_CHARACTER_TWO_OFFSET)
+
+#define SPRITE_JUMP_PAD_OFFSET 1006
+#define SPRITE_JUMP_PAD_WIDTH 16
+#define SPRITE_JUMP_PAD_HEIGHT 16
+#define jumpPad (spritePixels + SPRITE_JUMP_PAD_OFFSET)
+
+#define SPRITE_MAIN_CHAR_OFFSET 1245
+#define SPRITE_MAIN_CHAR_WIDTH 16
+#define SPRITE_MAIN_CHAR_HEIGHT 16
+#define mainChar (spritePixels + SPRITE_MAIN_CHAR_OFFSET)
+
+#define SPRITE_TRIANGLE1_OFFSET 1484
+#define SPRITE_TRIANGLE1_WIDTH 16
+#define SPRITE_TRIANGLE1_HEIGHT 16
+#define triangle1 (spritePixels + SPRITE_TRIANGLE1_OFFSET)
+
+#endif // SPRITES_H
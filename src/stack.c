@@ -0,0 +1,98 @@
+#include "stack.h"
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+#include "display.h"
+
+// From the linker script
+extern uint32_t _ebss;
+extern uint32_t _estack;
+
+#define STACK_BOTTOM (&_ebss)
+#define STACK_TOP (&_estack)
+
+void stackPaint(void)
+{
+	uintptr_t sp;
+	__asm volatile (" mov %0, sp " : "=r" (sp));
+	// Leave a little room below our own frame for the loop itself
+	uint32_t *limit = (uint32_t *)(sp - 16);
+	for (uint32_t *p = STACK_BOTTOM; p < limit; p++)
+		*p = STACK_PAINT;
+}
+uint32_t stackHighWater(void)
+{
+	// Skip the guard band: if that has been touched stackGuardCheck catches it
+	uint32_t *p = STACK_BOTTOM + STACK_GUARD_BYTES / 4;
+	while (p < STACK_TOP && *p == STACK_PAINT)
+		p++;
+	return (uint32_t)((uint8_t *)STACK_TOP - (uint8_t *)p);
+}
+uint32_t stackSize(void)
+{
+	return (uint32_t)((uint8_t *)STACK_TOP - (uint8_t *)STACK_BOTTOM);
+}
+static void stackOverflowTrap(void)
+{
+	__asm(" cpsid i ");
+	GPIOB->ODR |= (1 << 0); // red LED
+	for (uint16_t x = 0; x < SCREEN_WIDTH; x += 16)
+		fillRectangle(x, 0, 8, SCREEN_HEIGHT, RGBToWord(0xff, 0, 0));
+	for (uint16_t x = 8; x < SCREEN_WIDTH; x += 16)
+		fillRectangle(x, 0, 8, SCREEN_HEIGHT, RGBToWord(0xff, 0xff, 0xff));
+	while (1)
+	{
+		__asm(" bkpt 0 "); // halts under a debugger; without one this escalates to HardFault, which spins too
+	}
+}
+void stackGuardCheck(void)
+{
+	for (uint32_t *p = STACK_BOTTOM; p < STACK_BOTTOM + STACK_GUARD_BYTES / 4; p++)
+	{
+		if (*p != STACK_PAINT)
+			stackOverflowTrap();
+	}
+}
+#else
+// The host has a real stack and real guard pages
+void stackPaint(void)
+{
+}
+uint32_t stackHighWater(void)
+{
+	return 0;
+}
+uint32_t stackSize(void)
+{
+	return 0;
+}
+void stackGuardCheck(void)
+{
+}
+#endif
+
+static char *putNumber(char *p, uint32_t v)
+{
+	char tmp[10];
+	int n = 0;
+	do {
+		tmp[n++] = (char)('0' + v % 10);
+		v /= 10;
+	} while (v);
+	while (n) *p++ = tmp[--n];
+	return p;
+}
+void stackReport(void (*writeLine)(const char *line))
+{
+	char line[32];
+	char *p = line;
+	const char *s = "stack ";
+	while (*s) *p++ = *s++;
+	p = putNumber(p, stackHighWater());
+	*p++ = '/';
+	p = putNumber(p, stackSize());
+	s = " bytes\r\n";
+	while (*s) *p++ = *s++;
+	*p = 0;
+	writeLine(line);
+}
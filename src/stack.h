@@ -0,0 +1,32 @@
+#ifndef STACK_H
+#define STACK_H
+#include <stdint.h>
+
+// ============================================
+// STACK MONITOR
+// The stack grows down from the top of RAM towards the end of .bss, with
+// nothing in between to stop it.  stackPaint() fills the unused stack with
+// STACK_PAINT at startup; stackHighWater() finds how far down the paint has
+// been overwritten.  The lowest STACK_GUARD_BYTES are a guard band that
+// stackGuardCheck() verifies once a frame: if anything has written there
+// the stack has reached (or is about to reach) the globals, so it stops the
+// game with red and white stripes on the screen and the red LED on rather
+// than carrying on with corrupt state.
+//
+// For the worst case by call path, build env nucleo_f031k6_stack and run
+// tools/stack_report.py on its build directory.
+// ============================================
+#define STACK_PAINT 0xcdcdcdcdu
+#define STACK_GUARD_BYTES 32
+
+// Call first thing in main()
+void stackPaint(void);
+// Deepest the stack has been, in bytes
+uint32_t stackHighWater(void);
+// Space between the end of .bss and the top of RAM
+uint32_t stackSize(void);
+void stackGuardCheck(void);
+// One line for the serial port: "stack 812/1508 bytes\r\n"
+void stackReport(void (*writeLine)(const char *line));
+
+#endif
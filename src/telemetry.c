@@ -0,0 +1,53 @@
+#include "telemetry.h"
+#include "crc.h"
+#include "serial.h"
+
+#if TELEMETRY_ENABLED
+static uint8_t period = TELEMETRY_PERIOD_FRAMES;
+static uint8_t countdown;
+static uint16_t sequence;
+
+static uint16_t saturate16(uint32_t v)
+{
+	return (v > 0xffff) ? 0xffff : (uint16_t)v;
+}
+void telemetrySetPeriod(uint8_t frames)
+{
+	period = frames;
+	countdown = 0;
+}
+void telemetryFrame(const TelemetryFrame *f)
+{
+	if (period == 0)
+		return;
+	if (countdown)
+	{
+		countdown--;
+		return;
+	}
+	countdown = (uint8_t)(period - 1);
+
+	uint8_t rec[TELEMETRY_FRAME_SIZE];
+	uint16_t frameTime = saturate16(f->frameTime);
+	uint16_t busBytes = saturate16(f->busBytes);
+	rec[0] = TELEMETRY_SYNC;
+	rec[1] = TELEMETRY_FRAME;
+	rec[2] = (uint8_t)sequence;
+	rec[3] = (uint8_t)(sequence >> 8);
+	rec[4] = (uint8_t)frameTime;
+	rec[5] = (uint8_t)(frameTime >> 8);
+	rec[6] = (uint8_t)busBytes;
+	rec[7] = (uint8_t)(busBytes >> 8);
+	rec[8] = (uint8_t)f->deaths;
+	rec[9] = (uint8_t)(f->deaths >> 8);
+	rec[10] = (uint8_t)f->scroll;
+	rec[11] = (uint8_t)((uint32_t)f->scroll >> 8);
+	rec[12] = (uint8_t)((uint32_t)f->scroll >> 16);
+	rec[13] = (uint8_t)((uint32_t)f->scroll >> 24);
+	rec[14] = f->height;
+	rec[15] = f->flags;
+	rec[16] = crc8(&rec[1], TELEMETRY_FRAME_SIZE - 2);
+	sequence++; // counted even when dropped so the decoder can see the gap
+	serialWrite(rec, TELEMETRY_FRAME_SIZE);
+}
+#endif
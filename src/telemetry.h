@@ -0,0 +1,58 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include <stdint.h>
+
+// ============================================
+// TELEMETRY
+// Binary frame records streamed over the serial port for soak runs.
+// Decode on the host with tools/telemetry_decode.py.
+//
+// Record layout (little endian):
+//   0   u8   TELEMETRY_SYNC
+//   1   u8   record type (TELEMETRY_FRAME)
+//   2   u16  sequence number (gaps = records dropped because TX was full)
+//   4   u16  frame time, microseconds (saturates)
+//   6   u16  bytes sent to the panel this frame (saturates)
+//   8   u16  deaths
+//   10  i32  scroll position, pixels
+//   14  u8   player height above the floor, pixels
+//   15  u8   flags (TELEMETRY_FLAG_*, quality level in bits 2-4)
+//   16  u8   CRC-8 (poly 0x07) of bytes 1..15
+// ============================================
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED 0
+#endif
+// Send one record every N gameplay frames (0 = off); can be changed at runtime
+#ifndef TELEMETRY_PERIOD_FRAMES
+#define TELEMETRY_PERIOD_FRAMES 4
+#endif
+
+#define TELEMETRY_SYNC 0xa5
+#define TELEMETRY_FRAME 0x01
+#define TELEMETRY_FRAME_SIZE 17
+
+#define TELEMETRY_FLAG_IN_AIR 0x01
+#define TELEMETRY_FLAG_WON 0x02
+#define TELEMETRY_FLAG_QUALITY_SHIFT 2 // governor level, see governor.h
+#define TELEMETRY_FLAG_QUALITY_MASK 0x1c
+
+typedef struct {
+	uint32_t frameTime;   // microseconds
+	uint32_t busBytes;
+	uint16_t deaths;
+	int32_t scroll;
+	uint8_t height;
+	uint8_t flags;
+} TelemetryFrame;
+
+#if TELEMETRY_ENABLED
+void telemetrySetPeriod(uint8_t frames);
+// Call once per gameplay frame; only every Nth call is sent.  Never blocks:
+// if the TX buffer can't take the whole record it's dropped.
+void telemetryFrame(const TelemetryFrame *f);
+#else
+#define telemetrySetPeriod(frames) (void)0
+#define telemetryFrame(f) (void)0
+#endif
+
+#endif
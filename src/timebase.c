@@ -0,0 +1,77 @@
+#include "timebase.h"
+
+#ifndef HOST_BUILD
+#include <stm32f031x6.h>
+
+void TIM2_IRQHandler(void);
+
+void timebaseInit(void)
+{
+	RCC->APB1ENR |= (1 << 0);                          // Turn on TIM2
+	TIM2->CR1 = 0;
+	TIM2->PSC = (TIMEBASE_CLOCK_HZ / 1000000u) - 1;   // 1 tick per microsecond
+	TIM2->ARR = 0xffffffffu;                           // free running over the full 32 bits
+	TIM2->CCMR1 = 0;                                   // channel 1 is a plain output compare (frozen)
+	TIM2->EGR = (1 << 0);                              // load the prescaler now
+	TIM2->SR = 0;
+	TIM2->DIER = 0;
+	NVIC_EnableIRQ(TIM2_IRQn);
+	TIM2->CR1 = (1 << 0);                              // count up, enable
+	__asm(" cpsie i "); // enable interrupts
+}
+uint32_t micros(void)
+{
+	// A single 32 bit register read, so there's no high/low word race to handle
+	return TIM2->CNT;
+}
+void TIM2_IRQHandler(void)
+{
+	// Only here to wake the core out of delay_us
+	TIM2->SR = ~(1u << 1);    // clear CC1IF
+}
+void delay_us(uint32_t us)
+{
+	uint32_t end_time = TIM2->CNT + us;
+	TIM2->CCR1 = end_time;
+	TIM2->SR = ~(1u << 1);    // clear any stale compare flag
+	TIM2->DIER |= (1 << 1);   // interrupt on compare match 1
+	// Interrupts are masked around the check so the match can't slip in between
+	// the test and the wfi; a pending interrupt still wakes wfi with PRIMASK set
+	__asm(" cpsid i ");
+	while ((int32_t)(TIM2->CNT - end_time) < 0)
+	{
+		__asm(" wfi "); // sleep
+		__asm(" cpsie i ");
+		__asm(" cpsid i ");
+	}
+	__asm(" cpsie i ");
+	TIM2->DIER &= ~(1u << 1);
+}
+#else
+#include <time.h>
+
+static struct timespec startTime;
+
+void timebaseInit(void)
+{
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+}
+uint32_t micros(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((now.tv_sec - startTime.tv_sec) * 1000000LL + (now.tv_nsec - startTime.tv_nsec) / 1000);
+}
+void delay_us(uint32_t us)
+{
+	struct timespec ts;
+	ts.tv_sec = us / 1000000u;
+	ts.tv_nsec = (long)(us % 1000000u) * 1000;
+	nanosleep(&ts, 0);
+}
+#endif
+
+void delay(uint32_t ms)
+{
+	delay_us(ms * 1000u);
+}
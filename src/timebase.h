@@ -0,0 +1,17 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+#include <stdint.h>
+
+// Free-running microsecond clock.  On the F031 this is TIM2 (32 bit) ticking
+// at 1MHz, so it wraps after ~71 minutes: always compare times by unsigned
+// subtraction, e.g. (micros() - start) > 200000.
+// Core clock the timer prescaler is worked out from (see initClock)
+#define TIMEBASE_CLOCK_HZ 48000000u
+
+void timebaseInit(void);
+uint32_t micros(void);
+// Both of these sleep until a timer compare match rather than waking on a tick
+void delay_us(uint32_t us);
+void delay(uint32_t ms);
+
+#endif
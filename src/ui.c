@@ -0,0 +1,104 @@
+#include <string.h>
+#include "ui.h"
+#include "display.h"
+#include "font5x7.h"
+#include "arena.h"
+#include "game.h"
+#include "sprite_map.h"
+#include "ui_images.h"
+#include "widget.h"
+
+const uint16_t *const characterTable[NUM_CHARACTERS] = { mainChar, characterOne, characterTwo, characterThree };
+static const char *const characterNames[NUM_CHARACTERS] = { "CLASSIC", "BLUE", "IDIOT", "CHECKER" };
+
+// Widgets of each screen, in drawing order
+enum { MENU_LEVEL, MENU_PRACTICE, MENU_CHARACTER, MENU_HINT, MENU_COUNT };
+enum { CS_PREVIEW, CS_NAME, CS_LEFT, CS_RIGHT, CS_NUMBER, CS_TOTAL, CS_COUNT };
+_Static_assert(MENU_COUNT <= MENU_WIDGETS && CS_COUNT <= MENU_WIDGETS, "menu overlay too small");
+
+static Widget *place(Widget *w, uint8_t kind, int x, int y, uint16_t colour)
+{
+	memset(w, 0, sizeof(*w));
+	w->kind = kind;
+	w->flags = WIDGET_SHOWN;
+	w->x = (uint8_t)x;
+	w->y = (uint8_t)y;
+	w->scale = 1;
+	w->colour = colour;
+	return w;
+}
+static void placeSprite(Widget *w, int x, int y, const uint16_t *sprite)
+{
+	place(w, WIDGET_SPRITE, x, y, 0)->value.sprite = sprite;
+	w->w = MAIN_CHARACTER_SPRITE_SIZE_X;
+	w->h = MAIN_CHARACTER_SPRITE_SIZE_Y;
+}
+
+// The layer holds the title, floor, spikes and control hints
+void drawMenu(int level, int character, int practice)
+{
+	Widget *w = arena.mode.menu.widgets;
+	arenaEnter(ARENA_MENU);
+	// Level number, after the "LEVEL " in the layer
+	place(&w[MENU_LEVEL], WIDGET_NUMBER, SCREEN_CENTER_X + 8, 68, RGBToWord(0xff, 0xff, 0x00))->value.number = (uint16_t)(level + 1);
+	// In the gap between the level and the hints
+	place(&w[MENU_PRACTICE], WIDGET_TEXT, SCREEN_CENTER_X - 27, 78, RGBToWord(0x00, 0xff, 0x00))->value.text = "PRACTICE";
+	w[MENU_PRACTICE].flags = practice ? WIDGET_SHOWN : 0;
+	// Player character on the ground
+	placeSprite(&w[MENU_CHARACTER], SCREEN_CENTER_X - 8, FLOOR_TOP - MAIN_CHARACTER_SPRITE_SIZE_Y, characterTable[character]);
+	// In landscape the character stands on this hint, which goes on top
+	place(&w[MENU_HINT], WIDGET_TEXT, SCREEN_CENTER_X - 28, 98, RGBToWord(0xff, 0xff, 0xff))->value.text = "CHARACTER";
+	widgetScreen(w, MENU_COUNT, uiMenuPalette, uiMenuRLE, 0);
+	widgetInvalidate(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+	widgetUpdate();
+}
+
+void drawMenuPractice(int practice)
+{
+	widgetShow(&arena.mode.menu.widgets[MENU_PRACTICE], practice);
+	widgetUpdate();
+}
+
+// The layer holds the title, floor, arrows and exit hint
+void drawCharSelect(int character)
+{
+	Widget *w = arena.mode.menu.widgets;
+	uint16_t white = RGBToWord(0xff, 0xff, 0xff);
+	placeSprite(&w[CS_PREVIEW], SCREEN_CENTER_X - 8, 40, characterTable[character]);
+	place(&w[CS_NAME], WIDGET_TEXT, SCREEN_CENTER_X - 28, 62, RGBToWord(0xff, 0xff, 0x00))->value.text = characterNames[character];
+	place(&w[CS_LEFT], WIDGET_ARROW, SCREEN_CENTER_X - 30, 44, white)->dir = ARROW_LEFT;
+	place(&w[CS_RIGHT], WIDGET_ARROW, SCREEN_CENTER_X + 20, 44, white)->dir = ARROW_RIGHT;
+	// The total overlaps the selection's leading zeros, so it comes after
+	place(&w[CS_NUMBER], WIDGET_NUMBER, SCREEN_CENTER_X - 6, 78, white)->value.number = (uint16_t)(character + 1);
+	place(&w[CS_TOTAL], WIDGET_NUMBER, SCREEN_CENTER_X + 10, 78, white)->value.number = NUM_CHARACTERS;
+	widgetScreen(w, CS_COUNT, uiCharselectPalette, uiCharselectRLE, 0);
+	widgetInvalidate(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+	widgetUpdate();
+}
+
+void drawCharSelectChoice(int character, int direction)
+{
+	Widget *w = arena.mode.menu.widgets;
+	uint16_t white = RGBToWord(0xff, 0xff, 0xff);
+	uint16_t lit = RGBToWord(0xff, 0xff, 0x00);
+	widgetSetSprite(&w[CS_PREVIEW], characterTable[character]);
+	widgetSetText(&w[CS_NAME], characterNames[character]);
+	widgetSetColour(&w[CS_LEFT], direction < 0 ? lit : white);
+	widgetSetColour(&w[CS_RIGHT], direction > 0 ? lit : white);
+	widgetSetNumber(&w[CS_NUMBER], (uint16_t)(character + 1));
+	widgetUpdate();
+}
+
+// Not a widget: clearing behind the text before drawing it would double
+// the bytes sent, and the frozen playfield only needs the text on top
+#define PAUSED_X (SCREEN_CENTER_X - 36)
+#define PAUSED_Y 55
+#define PAUSED_WIDTH (6 * (FONT_WIDTH * 2 + 2) - 2) // printTextX2 of 6 letters
+
+void drawPaused(int shown)
+{
+	if (shown)
+		printTextX2("PAUSED", PAUSED_X, PAUSED_Y, RGBToWord(0xff, 0xff, 0xff), 0);
+	else
+		fillRectangle(PAUSED_X, PAUSED_Y, PAUSED_WIDTH, FONT_HEIGHT * 2, 0);
+}
@@ -0,0 +1,29 @@
+#ifndef UI_H
+#define UI_H
+#include <stdint.h>
+
+// ============================================
+// MENU SCREENS
+// Each screen is a pre-rendered layer (assets/ui/, compiled into
+// ui_images.c) with the parts that depend on the current choices as
+// widgets over it (widget.h).  A full draw streams the layer in one
+// aperture; a change of choice redraws only the widgets that changed and
+// the bit of layer under them.  Changing the image means changing the
+// PNG; the layer must leave the widget areas as they are drawn here
+// (black background under the text).
+// ============================================
+#define NUM_CHARACTERS 4
+extern const uint16_t *const characterTable[NUM_CHARACTERS];
+
+// practice: show the PRACTICE flag under the level
+void drawMenu(int level, int character, int practice);
+// Flag practice mode on or off on the screen drawMenu put up
+void drawMenuPractice(int practice);
+void drawCharSelect(int character);
+// Change the choice on the screen drawCharSelect put up, lighting the
+// arrow for direction (-1 left, 1 right, 0 neither)
+void drawCharSelectChoice(int character, int direction);
+// The PAUSED label over the playfield, or the playfield's black again
+void drawPaused(int shown);
+
+#endif
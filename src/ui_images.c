@@ -0,0 +1,215 @@
+// Generated by tools/asset_compiler.py from assets/ui/; edit the images, not this file.
+#include "ui_images.h"
+
+#if SCREEN_WIDTH == 128 && SCREEN_HEIGHT == 160
+const uint16_t uiPalette[UI_PALETTE_WORDS] = {
+	// menu (128x160)
+	    0,27278,57351,33022,65535,63488, 7936,65287,
+	// charselect (128x160)
+	    0,27278,33022,65535,
+};
+const uint8_t uiRLE[UI_RLE_BYTES] = {
+	// menu (128x160)
+	240,255,240,255,240,255,240,255,240,255,240,255,240,164, 82, 48,146, 48, 82, 48,
+	 18, 80, 18, 16,146, 16,146, 16,114, 48, 18, 80, 18,240, 20, 82, 48,146, 48, 82,
+	 48, 18, 80, 18, 16,146, 16,146, 16,114, 48, 18, 80, 18,240, 18, 18, 80, 18, 16,
+	 18,144, 18, 80, 18, 16, 50, 16, 50, 16, 18,208, 18, 80, 18, 80, 18, 16, 18, 80,
+	 18,240, 18, 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 50, 16, 50, 16, 18,208, 18,
+	 80, 18, 80, 18, 16, 18, 80, 18,240, 18, 18,144, 18,144, 18, 80, 18, 16, 18, 16,
+	 18, 16, 18, 16, 18,208, 18, 80, 18, 80, 18, 48, 18, 16, 18,240, 20, 18,144, 18,
+	144, 18, 80, 18, 16, 18, 16, 18, 16, 18, 16, 18,208, 18, 80, 18, 80, 18, 48, 18,
+	 16, 18,240, 20, 18,144,114, 48, 18, 80, 18, 16, 18, 80, 18, 16,114,112, 18, 80,
+	114,112, 18,240, 22, 18,144,114, 48, 18, 80, 18, 16, 18, 80, 18, 16,114,112, 18,
+	 80,114,112, 18,240, 22, 18, 48, 50, 16, 18,144, 18, 80, 18, 16, 18, 80, 18, 16,
+	 18,208, 18, 80, 18, 16, 18,144, 18,240, 22, 18, 48, 50, 16, 18,144, 18, 80, 18,
+	 16, 18, 80, 18, 16, 18,208, 18, 80, 18, 16, 18,144, 18,240, 22, 18, 80, 18, 16,
+	 18,144, 18, 80, 18, 16, 18, 80, 18, 16, 18,208, 18, 80, 18, 48, 18,112, 18,240,
+	 22, 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 18, 80, 18, 16, 18,208, 18, 80, 18,
+	 48, 18,112, 18,240, 24, 82, 48,146, 48, 82, 48, 18, 80, 18, 16,146, 80, 18, 80,
+	 18, 80, 18, 80, 18,240, 24, 82, 48,146, 48, 82, 48, 18, 80, 18, 16,146, 80, 18,
+	 80, 18, 80, 18, 80, 18,240,255,240,255,240,255,240,255, 16, 83,112, 83, 80,115,
+	 16, 19, 80, 19,240, 66, 83,112, 83, 80,115, 16, 19, 80, 19,240, 66, 19, 48, 19,
+	 48, 19, 80, 19, 16, 19,144, 19, 80, 19,240, 66, 19, 48, 19, 48, 19, 80, 19, 16,
+	 19,144, 19, 80, 19,240, 66, 19, 80, 19, 16, 19, 80, 19, 16, 19,144, 19, 80, 19,
+	240, 66, 19, 80, 19, 16, 19, 80, 19, 16, 19,144, 19, 80, 19,240, 66, 19, 80, 19,
+	 16, 19, 80, 19, 48, 83, 48,147,240, 66, 19, 80, 19, 16, 19, 80, 19, 48, 83, 48,
+	147,240, 66, 19, 80, 19, 16,147,144, 19, 16, 19, 80, 19,240, 66, 19, 80, 19, 16,
+	147,144, 19, 16, 19, 80, 19,240, 66, 19, 48, 19, 48, 19, 80, 19,144, 19, 16, 19,
+	 80, 19,240, 66, 19, 48, 19, 48, 19, 80, 19,144, 19, 16, 19, 80, 19,240, 66, 83,
+	 80, 19, 80, 19, 16,115, 48, 19, 80, 19,240, 66, 83, 80, 19, 80, 19, 16,115, 48,
+	 19, 80, 19,240,255,240,255,240,255,240, 22, 54, 32, 38, 32,  6, 32,  6, 16, 70,
+	 16, 70, 16, 70, 16, 38,240, 67,  6, 80,  6, 32,  6, 16,  6, 32,  6, 16,  6, 80,
+	  6, 80,  6, 80,  6, 16,  6,240, 66,  6, 80,  6, 80,  6, 32,  6, 16,  6, 80,  6,
+	 80,  6, 80,  6, 32,  6,240, 66, 38, 32,  6, 80,  6, 32,  6, 16, 38, 48, 38, 48,
+	 54, 32,  6, 32,  6,240, 69,  6, 16,  6, 80,  6, 32,  6, 16,  6, 80,  6, 80,  6,
+	 80,  6, 32,  6,240, 69,  6, 16,  6, 32,  6, 16,  6, 32,  6, 16,  6, 80,  6, 80,
+	  6, 80,  6, 16,  6,240, 66, 54, 48, 38, 48, 38, 32,  6, 80,  6, 80, 70, 16, 38,
+	240,255,240,255,240,158,  7, 80, 71, 16,  7, 32,  7, 16, 71, 16,  7,240, 83,  7,
+	 80,  7, 80,  7, 32,  7, 16,  7, 80,  7,240, 83,  7, 80,  7, 80,  7, 32,  7, 16,
+	  7, 80,  7,240, 83,  7, 80, 55, 32,  7, 32,  7, 16, 55, 32,  7,240, 83,  7, 80,
+	  7, 80,  7, 32,  7, 16,  7, 80,  7,240, 83,  7, 80,  7, 96,  7,  0,  7, 32,  7,
+	 80,  7,240, 83, 71, 16, 71, 48,  7, 48, 71, 16, 71,240,255,240,255,240,255,240,
+	255,240,255,240,140, 52, 16, 68, 32, 36, 32, 52, 32, 68,240, 79,  4,112,  4, 48,
+	  4, 32,  4, 16,  4, 32,  4, 48,  4,240, 73,  7, 96,  4,112,  4, 48,  4, 32,  4,
+	 16,  4, 32,  4, 48,  4,240, 72, 39, 96, 36, 64,  4, 48,  4, 32,  4, 16, 52, 64,
+	  4,240, 71, 71,128,  4, 48,  4, 48, 68, 16,  4,  0,  4, 80,  4,240, 70,103,112,
+	  4, 48,  4, 48,  4, 32,  4, 16,  4, 16,  4, 64,  4,240, 69,135, 32, 52, 64,  4,
+	 48,  4, 32,  4, 16,  4, 32,  4, 48,  4,240,255,240,255,240,180, 36, 32,  4, 32,
+	  4, 32, 36, 32, 52, 48, 36, 48, 36, 32, 68, 16, 68, 16, 52,240, 52,  4, 32,  4,
+	 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4,
+	 48,  4, 48,  4, 80,  4, 32,  4,240, 39,  3,160,  4, 80,  4, 32,  4, 16,  4, 32,
+	  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4,112,  4, 48,  4, 80,  4, 32,  4,240,
+	 39, 19,144,  4, 80, 68, 16,  4, 32,  4, 16, 52, 32,  4, 32,  4, 16,  4,112,  4,
+	 48, 52, 32, 52,240, 40, 35,128,  4, 80,  4, 32,  4, 16, 68, 16,  4,  0,  4, 48,
+	 68, 16,  4,112,  4, 48,  4, 80,  4,  0,  4,240, 41, 51,112,  4, 32,  4, 16,  4,
+	 32,  4, 16,  4, 32,  4, 16,  4, 16,  4, 32,  4, 32,  4, 16,  4, 32,  4, 48,  4,
+	 48,  4, 80,  4, 16,  4,240, 40, 67,112, 36, 32,  4, 32,  4, 16,  4, 32,  4, 16,
+	  4, 32,  4, 16,  4, 32,  4, 32, 36, 64,  4, 48, 68, 16,  4, 32,  4,240, 39, 51,
+	240,108, 35,240,109, 19,240,110,  3,240,255,240,255,240,255,240,255,240,255,240,
+	255,240,255,240,255,240,255,240,219, 21,240, 86, 21,240,  6, 21,240, 86, 21,240,
+	  5, 53,240, 84, 53,240,  4, 53,240, 84, 53,240,  3, 85,240, 82, 85,240,  2, 85,
+	240, 82, 85,240,  1,117,240, 80,117,240,  0,117,240, 80,117,224,149,240, 78,149,
+	208,149,240, 78,149,192,181,240, 76,181,176,181,240, 76,181,160,213,240, 74,213,
+	240,117,241,255,241,255,241,255,241,255,241,255,241,255,241,255,241,255,113,
+	// charselect (128x160)
+	240,255,240,255,240,232,114, 16,146, 16, 18,144,146, 48, 82, 48,146,240, 44,114,
+	 16,146, 16, 18,144,146, 48, 82, 48,146,240, 42, 18,144, 18,144, 18,144, 18,144,
+	 18, 80, 18, 80, 18,240, 46, 18,144, 18,144, 18,144, 18,144, 18, 80, 18, 80, 18,
+	240, 46, 18,144, 18,144, 18,144, 18,144, 18,208, 18,240, 46, 18,144, 18,144, 18,
+	144, 18,144, 18,208, 18,240, 48, 82, 48,114, 48, 18,144,114, 48, 18,208, 18,240,
+	 48, 82, 48,114, 48, 18,144,114, 48, 18,208, 18,240, 54, 18, 16, 18,144, 18,144,
+	 18,144, 18,208, 18,240, 54, 18, 16, 18,144, 18,144, 18,144, 18,208, 18,240, 54,
+	 18, 16, 18,144, 18,144, 18,144, 18, 80, 18, 80, 18,240, 54, 18, 16, 18,144, 18,
+	144, 18,144, 18, 80, 18, 80, 18,240, 46,114, 48,146, 16,146, 16,146, 48, 82,112,
+	 18,240, 46,114, 48,146, 16,146, 16,146, 48, 82,112, 18,240,255,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,151,  3,240,
+	 37,  3,240, 57, 19,240, 35, 19,240, 57, 35,240, 33, 35,240, 57, 51,240, 31, 51,
+	240, 57, 67,240, 29, 67,240, 57, 51,240, 31, 51,240, 57, 35,240, 33, 35,240, 57,
+	 19,240, 35, 19,240, 57,  3,240, 37,  3,240,255,240,255,240,255,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,104, 35, 64, 35, 32,  3, 32,
+	  3, 16,  3, 32,  3,128, 67, 32, 35,160, 35, 48, 35,144, 51, 48, 35, 48, 35, 32,
+	  3, 32,  3,240,  9,  3, 16,  3, 32,  3, 32,  3, 16,  3, 32,  3, 16,  3, 32,  3,
+	160,  3, 48,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3,128,  3, 32,  3, 16,  3,
+	 32,  3, 16,  3, 32,  3, 16,  3, 16,  3,240, 10,  3, 32,  3, 16,  3, 32,  3, 16,
+	  3, 32,  3, 16, 19, 16,  3,160,  3, 48,  3, 32,  3,128,  3, 80,  3, 32,  3,128,
+	  3, 32,  3, 16,  3, 32,  3, 16,  3, 80,  3,  0,  3,240, 11,  3, 32,  3, 16,  3,
+	 32,  3, 16,  3,  0,  3,  0,  3, 16,  3,  0,  3,  0,  3,160,  3, 48,  3, 32,  3,
+	128,  3, 80,  3, 32,  3,128, 51, 32,  3, 32,  3, 16,  3, 80, 19,240, 12,  3, 32,
+	  3, 16,  3, 32,  3, 16,  3,  0,  3,  0,  3, 16,  3, 16, 19,160,  3, 48,  3, 32,
+	  3,128,  3, 16, 19, 16,  3, 32,  3,128,  3, 32,  3, 16, 67, 16,  3, 80,  3,  0,
+	  3,240, 11,  3, 16,  3, 32,  3, 32,  3, 16, 19,  0, 19, 16,  3, 32,  3,160,  3,
+	 48,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3,
+	 16,  3, 32,  3, 16,  3, 16,  3,240, 10, 35, 64, 35, 32,  3, 32,  3, 16,  3, 32,
+	  3,160,  3, 64, 35,160, 35, 48, 35,144, 51, 32,  3, 32,  3, 32, 35, 32,  3, 32,
+	  3,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,
+	255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,254,241,255,241,
+	255,241,255,241,255,241,255,241,255,241,255,241,255,113,
+};
+
+#elif SCREEN_WIDTH == 160 && SCREEN_HEIGHT == 128
+const uint16_t uiPalette[UI_PALETTE_WORDS] = {
+	// menu (160x128)
+	    0,27278,57351,33022,65535,63488, 7936,65287,
+	// charselect (160x128)
+	    0,27278,33022,65535,
+};
+const uint8_t uiRLE[UI_RLE_BYTES] = {
+	// menu (160x128)
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240, 86, 82, 48,
+	146, 48, 82, 48, 18, 80, 18, 16,146, 16,146, 16,114, 48, 18, 80, 18,240, 52, 82,
+	 48,146, 48, 82, 48, 18, 80, 18, 16,146, 16,146, 16,114, 48, 18, 80, 18,240, 50,
+	 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 50, 16, 50, 16, 18,208, 18, 80, 18, 80,
+	 18, 16, 18, 80, 18,240, 50, 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 50, 16, 50,
+	 16, 18,208, 18, 80, 18, 80, 18, 16, 18, 80, 18,240, 50, 18,144, 18,144, 18, 80,
+	 18, 16, 18, 16, 18, 16, 18, 16, 18,208, 18, 80, 18, 80, 18, 48, 18, 16, 18,240,
+	 52, 18,144, 18,144, 18, 80, 18, 16, 18, 16, 18, 16, 18, 16, 18,208, 18, 80, 18,
+	 80, 18, 48, 18, 16, 18,240, 52, 18,144,114, 48, 18, 80, 18, 16, 18, 80, 18, 16,
+	114,112, 18, 80,114,112, 18,240, 54, 18,144,114, 48, 18, 80, 18, 16, 18, 80, 18,
+	 16,114,112, 18, 80,114,112, 18,240, 54, 18, 48, 50, 16, 18,144, 18, 80, 18, 16,
+	 18, 80, 18, 16, 18,208, 18, 80, 18, 16, 18,144, 18,240, 54, 18, 48, 50, 16, 18,
+	144, 18, 80, 18, 16, 18, 80, 18, 16, 18,208, 18, 80, 18, 16, 18,144, 18,240, 54,
+	 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 18, 80, 18, 16, 18,208, 18, 80, 18, 48,
+	 18,112, 18,240, 54, 18, 80, 18, 16, 18,144, 18, 80, 18, 16, 18, 80, 18, 16, 18,
+	208, 18, 80, 18, 48, 18,112, 18,240, 56, 82, 48,146, 48, 82, 48, 18, 80, 18, 16,
+	146, 80, 18, 80, 18, 80, 18, 80, 18,240, 56, 82, 48,146, 48, 82, 48, 18, 80, 18,
+	 16,146, 80, 18, 80, 18, 80, 18, 80, 18,240,255,240,255,240,255,240,255,240,255,
+	240,  3, 83,112, 83, 80,115, 16, 19, 80, 19,240, 98, 83,112, 83, 80,115, 16, 19,
+	 80, 19,240, 98, 19, 48, 19, 48, 19, 80, 19, 16, 19,144, 19, 80, 19,240, 98, 19,
+	 48, 19, 48, 19, 80, 19, 16, 19,144, 19, 80, 19,240, 98, 19, 80, 19, 16, 19, 80,
+	 19, 16, 19,144, 19, 80, 19,240, 98, 19, 80, 19, 16, 19, 80, 19, 16, 19,144, 19,
+	 80, 19,240, 98, 19, 80, 19, 16, 19, 80, 19, 48, 83, 48,147,240, 98, 19, 80, 19,
+	 16, 19, 80, 19, 48, 83, 48,147,240, 98, 19, 80, 19, 16,147,144, 19, 16, 19, 80,
+	 19,240, 98, 19, 80, 19, 16,147,144, 19, 16, 19, 80, 19,240, 98, 19, 48, 19, 48,
+	 19, 80, 19,144, 19, 16, 19, 80, 19,240, 98, 19, 48, 19, 48, 19, 80, 19,144, 19,
+	 16, 19, 80, 19,240, 98, 83, 80, 19, 80, 19, 16,115, 48, 19, 80, 19,240, 98, 83,
+	 80, 19, 80, 19, 16,115, 48, 19, 80, 19,240,255,240,255,240,255,240,246, 54, 32,
+	 38, 32,  6, 32,  6, 16, 70, 16, 70, 16, 70, 16, 38,240, 99,  6, 80,  6, 32,  6,
+	 16,  6, 32,  6, 16,  6, 80,  6, 80,  6, 80,  6, 16,  6,240, 98,  6, 80,  6, 80,
+	  6, 32,  6, 16,  6, 80,  6, 80,  6, 80,  6, 32,  6,240, 98, 38, 32,  6, 80,  6,
+	 32,  6, 16, 38, 48, 38, 48, 54, 32,  6, 32,  6,240,101,  6, 16,  6, 80,  6, 32,
+	  6, 16,  6, 80,  6, 80,  6, 80,  6, 32,  6,240,101,  6, 16,  6, 32,  6, 16,  6,
+	 32,  6, 16,  6, 80,  6, 80,  6, 80,  6, 16,  6,240, 98, 54, 48, 38, 48, 38, 32,
+	  6, 80,  6, 80, 70, 16, 38,240,255,240,255,240,255,240, 79,  7, 80, 71, 16,  7,
+	 32,  7, 16, 71, 16,  7,240,115,  7, 80,  7, 80,  7, 32,  7, 16,  7, 80,  7,240,
+	115,  7, 80,  7, 80,  7, 32,  7, 16,  7, 80,  7,240,115,  7, 80, 55, 32,  7, 32,
+	  7, 16, 55, 32,  7,240,115,  7, 80,  7, 80,  7, 32,  7, 16,  7, 80,  7,240,115,
+	  7, 80,  7, 96,  7,  0,  7, 32,  7, 80,  7,240,115, 71, 16, 71, 48,  7, 48, 71,
+	 16, 71,240,255,240,255,240,255,240,255,240,255,240,255,240,253, 52, 16, 68, 32,
+	 36, 32, 52, 32, 68,240,111,  4,112,  4, 48,  4, 32,  4, 16,  4, 32,  4, 48,  4,
+	240,105,  7, 96,  4,112,  4, 48,  4, 32,  4, 16,  4, 32,  4, 48,  4,240,104, 39,
+	 96, 36, 64,  4, 48,  4, 32,  4, 16, 52, 64,  4,240,103, 71,128,  4, 48,  4, 48,
+	 68, 16,  4,  0,  4, 80,  4,240,102,103,112,  4, 48,  4, 48,  4, 32,  4, 16,  4,
+	 16,  4, 64,  4,240,101,135, 32, 52, 64,  4, 48,  4, 32,  4, 16,  4, 32,  4, 48,
+	  4,240,255,240,255,240,186, 21,240, 86, 21,240, 38, 21,240,  8, 36, 32,  4, 32,
+	  4, 32, 36, 32, 52, 48, 36, 48, 36, 32, 68, 16, 68, 16, 52,240,  3, 21,240, 37,
+	 53,240,  6,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4,
+	 32,  4, 16,  4, 32,  4, 48,  4, 48,  4, 80,  4, 32,  4,240,  1, 53,240, 36, 53,
+	144,  3,160,  4, 80,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4,
+	 16,  4,112,  4, 48,  4, 80,  4, 32,  4,240,  1, 53,240, 35, 85,128, 19,144,  4,
+	 80, 68, 16,  4, 32,  4, 16, 52, 32,  4, 32,  4, 16,  4,112,  4, 48, 52, 32, 52,
+	240,  1, 85,240, 34, 85,128, 35,128,  4, 80,  4, 32,  4, 16, 68, 16,  4,  0,  4,
+	 48, 68, 16,  4,112,  4, 48,  4, 80,  4,  0,  4,240,  2, 85,240, 33,117,112, 51,
+	112,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 16,  4, 32,  4, 32,  4,
+	 16,  4, 32,  4, 48,  4, 48,  4, 80,  4, 16,  4,240,  0,117,240, 32,117,112, 67,
+	112, 36, 32,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 16,  4, 32,  4, 32, 36,
+	 64,  4, 48, 68, 16,  4, 32,  4,224,117,240, 31,149, 96, 51,240, 67,149,240, 30,
+	149, 96, 35,240, 68,149,240, 29,181, 80, 19,240, 68,181,240, 28,181, 80,  3,240,
+	 69,181,240, 27,213,240, 74,213,240,165,241,255,241,255,241,255,241,255,241,255,
+	241,255,241,255,241,255,241,255,241,255,145,
+	// charselect (160x128)
+	240,255,240,255,240,255,240,169,114, 16,146, 16, 18,144,146, 48, 82, 48,146,240,
+	 76,114, 16,146, 16, 18,144,146, 48, 82, 48,146,240, 74, 18,144, 18,144, 18,144,
+	 18,144, 18, 80, 18, 80, 18,240, 78, 18,144, 18,144, 18,144, 18,144, 18, 80, 18,
+	 80, 18,240, 78, 18,144, 18,144, 18,144, 18,144, 18,208, 18,240, 78, 18,144, 18,
+	144, 18,144, 18,144, 18,208, 18,240, 80, 82, 48,114, 48, 18,144,114, 48, 18,208,
+	 18,240, 80, 82, 48,114, 48, 18,144,114, 48, 18,208, 18,240, 86, 18, 16, 18,144,
+	 18,144, 18,144, 18,208, 18,240, 86, 18, 16, 18,144, 18,144, 18,144, 18,208, 18,
+	240, 86, 18, 16, 18,144, 18,144, 18,144, 18, 80, 18, 80, 18,240, 86, 18, 16, 18,
+	144, 18,144, 18,144, 18, 80, 18, 80, 18,240, 78,114, 48,146, 16,146, 16,146, 48,
+	 82,112, 18,240, 78,114, 48,146, 16,146, 16,146, 48, 82,112, 18,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,
+	240,255,240,255,240,138,  3,240, 37,  3,240, 89, 19,240, 35, 19,240, 89, 35,240,
+	 33, 35,240, 89, 51,240, 31, 51,240, 89, 67,240, 29, 67,240, 89, 51,240, 31, 51,
+	240, 89, 35,240, 33, 35,240, 89, 19,240, 35, 19,240, 89,  3,240, 37,  3,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,240,255,
+	240,255,240,255,240,255,240,255,240,255,240,221, 35, 64, 35, 32,  3, 32,  3, 16,
+	  3, 32,  3,128, 67, 32, 35,160, 35, 48, 35,144, 51, 48, 35, 48, 35, 32,  3, 32,
+	  3,240, 41,  3, 16,  3, 32,  3, 32,  3, 16,  3, 32,  3, 16,  3, 32,  3,160,  3,
+	 48,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3,
+	 16,  3, 32,  3, 16,  3, 16,  3,240, 42,  3, 32,  3, 16,  3, 32,  3, 16,  3, 32,
+	  3, 16, 19, 16,  3,160,  3, 48,  3, 32,  3,128,  3, 80,  3, 32,  3,128,  3, 32,
+	  3, 16,  3, 32,  3, 16,  3, 80,  3,  0,  3,240, 43,  3, 32,  3, 16,  3, 32,  3,
+	 16,  3,  0,  3,  0,  3, 16,  3,  0,  3,  0,  3,160,  3, 48,  3, 32,  3,128,  3,
+	 80,  3, 32,  3,128, 51, 32,  3, 32,  3, 16,  3, 80, 19,240, 44,  3, 32,  3, 16,
+	  3, 32,  3, 16,  3,  0,  3,  0,  3, 16,  3, 16, 19,160,  3, 48,  3, 32,  3,128,
+	  3, 16, 19, 16,  3, 32,  3,128,  3, 32,  3, 16, 67, 16,  3, 80,  3,  0,  3,240,
+	 43,  3, 16,  3, 32,  3, 32,  3, 16, 19,  0, 19, 16,  3, 32,  3,160,  3, 48,  3,
+	 32,  3,128,  3, 32,  3, 16,  3, 32,  3,128,  3, 32,  3, 16,  3, 32,  3, 16,  3,
+	 32,  3, 16,  3, 16,  3,240, 42, 35, 64, 35, 32,  3, 32,  3, 16,  3, 32,  3,160,
+	  3, 64, 35,160, 35, 48, 35,144, 51, 32,  3, 32,  3, 32, 35, 32,  3, 32,  3,240,
+	255,240,255,240,255,240,160,241,255,241,255,241,255,241,255,241,255,241,255,241,
+	255,241,255,241,255,241,255,145,
+};
+#endif
@@ -0,0 +1,48 @@
+#ifndef UI_IMAGES_H
+#define UI_IMAGES_H
+// Generated by tools/asset_compiler.py from assets/ui/; edit the images, not this file.
+
+#include <stdint.h>
+#include "display_config.h"
+
+// Full-screen UI layers as a palette and run lengths each, drawn with
+// putImageRLE.  Palettes live in uiPalette and runs in uiRLE
+// (ui_images.c); identical palettes and runs are stored once.
+#if SCREEN_WIDTH == 128 && SCREEN_HEIGHT == 160
+#define UI_PALETTE_WORDS 12
+#define UI_RLE_BYTES 1873
+#define UI_CHARSELECT_WIDTH 128
+#define UI_CHARSELECT_HEIGHT 160
+#define UI_CHARSELECT_PALETTE_OFFSET 8
+#define UI_CHARSELECT_RLE_OFFSET 1219
+#define uiCharselectPalette (uiPalette + UI_CHARSELECT_PALETTE_OFFSET)
+#define uiCharselectRLE (uiRLE + UI_CHARSELECT_RLE_OFFSET)
+#define UI_MENU_WIDTH 128
+#define UI_MENU_HEIGHT 160
+#define UI_MENU_PALETTE_OFFSET 0
+#define UI_MENU_RLE_OFFSET 0
+#define uiMenuPalette (uiPalette + UI_MENU_PALETTE_OFFSET)
+#define uiMenuRLE (uiRLE + UI_MENU_RLE_OFFSET)
+#elif SCREEN_WIDTH == 160 && SCREEN_HEIGHT == 128
+#define UI_PALETTE_WORDS 12
+#define UI_RLE_BYTES 1859
+#define UI_CHARSELECT_WIDTH 160
+#define UI_CHARSELECT_HEIGHT 128
+#define UI_CHARSELECT_PALETTE_OFFSET 8
+#define UI_CHARSELECT_RLE_OFFSET 1211
+#define uiCharselectPalette (uiPalette + UI_CHARSELECT_PALETTE_OFFSET)
+#define uiCharselectRLE (uiRLE + UI_CHARSELECT_RLE_OFFSET)
+#define UI_MENU_WIDTH 160
+#define UI_MENU_HEIGHT 128
+#define UI_MENU_PALETTE_OFFSET 0
+#define UI_MENU_RLE_OFFSET 0
+#define uiMenuPalette (uiPalette + UI_MENU_PALETTE_OFFSET)
+#define uiMenuRLE (uiRLE + UI_MENU_RLE_OFFSET)
+#else
+#error "No UI images for this screen size: add assets/ui/<name>_<width>x<height>.png"
+#endif
+
+extern const uint16_t uiPalette[UI_PALETTE_WORDS];
+extern const uint8_t uiRLE[UI_RLE_BYTES];
+
+#endif // UI_IMAGES_H
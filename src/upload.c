@@ -0,0 +1,239 @@
+#include "upload.h"
+#include "serial.h"
+#include "arena.h"
+#include "crc.h"
+#include "timebase.h"
+
+#define UPLOAD_MAGIC 0x564c // "LV"
+#define FRAME_HEAD 3        // sync, type, payload length
+_Static_assert(UPLOAD_FRAME_MAX == FRAME_HEAD + UPLOAD_PAYLOAD + 2, "frame layout");
+
+// The frame coming in is put together in the arena's menu overlay
+static uint8_t frameLen;      // bytes of it in so far
+static uint32_t frameStart;   // when its sync byte came
+static uint16_t uploadLength; // columns of the upload under way, 0 if none
+static uint16_t received;     // tile bytes of it written
+
+static const uint8_t *page(void)
+{
+	return flashPage(FLASH_LEVEL_FIRST);
+}
+static uint16_t get16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+static uint16_t tileBytes(uint16_t length)
+{
+	return (uint16_t)(length * LEVEL_ROWS);
+}
+
+// 1 if the page holds a whole level
+static int pageValid(void)
+{
+	const uint8_t *p = page();
+	uint16_t length = get16(p + 2), check = (uint16_t)~length;
+	return get16(p) == UPLOAD_MAGIC && get16(p + 4) == check && length && length <= UPLOAD_MAX_LENGTH
+		&& get16(p + 6) == crc16(0xffff, p + UPLOAD_HEADER, tileBytes(length));
+}
+// Point LEVEL_UPLOADED's entry at the page
+static void mapLevel(uint16_t length)
+{
+	LevelInfo *level = &uploadedLevel;
+	for (int r = 0; r < LEVEL_ROWS; r++)
+		level->rows[r] = page() + UPLOAD_HEADER + r * length;
+	level->length = length;
+	numLevels = NUM_LEVELS + 1;
+}
+
+void uploadInit(void)
+{
+	frameLen = 0;
+	uploadLength = 0;
+	numLevels = NUM_LEVELS;
+	if (pageValid())
+		mapLevel(get16(page() + 2));
+}
+
+// "UPLOAD <what>", with " <count>" unless count is negative
+static void reply(const char *what, int32_t count)
+{
+	char line[24];
+	char *p = line;
+	const char *s = "UPLOAD ";
+	while (*s) *p++ = *s++;
+	while (*what) *p++ = *what++;
+	if (count >= 0)
+	{
+		char tmp[6];
+		int n = 0;
+		*p++ = ' ';
+		do {
+			tmp[n++] = (char)('0' + count % 10);
+			count /= 10;
+		} while (count);
+		while (n) *p++ = tmp[--n];
+	}
+	*p++ = '\r';
+	*p++ = '\n';
+	*p = 0;
+	eputs(line);
+}
+static int refuse(void)
+{
+	reply("NO", -1);
+	return UPLOAD_IDLE;
+}
+
+// Flash time the frame in hand takes at worst
+static uint32_t frameCost(const uint8_t *frame)
+{
+	switch (frame[1])
+	{
+		case UPLOAD_BEGIN: return FLASH_ERASE_US;
+		case UPLOAD_DATA: return (uint32_t)(frame[2] / 2) * FLASH_PROGRAM_US;
+		default: return UPLOAD_HEADER / 2 * FLASH_PROGRAM_US;
+	}
+}
+
+static int handleFrame(const uint8_t *frame)
+{
+	const uint8_t *payload = frame + FRAME_HEAD;
+	uint8_t n = frame[2];
+	switch (frame[1])
+	{
+		case UPLOAD_BEGIN:
+		{
+			uint16_t length = n == 3 ? get16(payload) : 0;
+			if (!length || length > UPLOAD_MAX_LENGTH || payload[2] != LEVEL_ROWS)
+				return refuse();
+			// The old level goes as soon as its page does
+			uploadLength = 0;
+			numLevels = NUM_LEVELS;
+			if (!flashErasePage(FLASH_LEVEL_FIRST))
+			{
+				refuse();
+				return UPLOAD_CLEARED;
+			}
+			uploadLength = length;
+			received = 0;
+			reply("OK", 0);
+			return UPLOAD_CLEARED;
+		}
+
+		case UPLOAD_DATA:
+		{
+			uint16_t offset = get16(payload), len = (uint16_t)(n - 2);
+			const uint8_t *tiles = payload + 2;
+			if (n < 3 || !uploadLength || (offset & 1) || offset + len > tileBytes(uploadLength))
+				return refuse();
+			if (offset + len <= received)
+			{
+				// Sent again after its answer went missing
+				const uint8_t *at = page() + UPLOAD_HEADER + offset;
+				for (uint16_t i = 0; i < len; i++)
+				{
+					if (at[i] != tiles[i])
+						return refuse();
+				}
+			}
+			else if (offset != received)
+			{
+				return refuse();
+			}
+			else if (!flashProgram(FLASH_LEVEL_FIRST, (uint16_t)(UPLOAD_HEADER + offset), tiles, len))
+			{
+				uploadLength = 0;
+				return refuse();
+			}
+			else
+			{
+				received = (uint16_t)(received + len);
+			}
+			reply("OK", received);
+			return UPLOAD_IDLE;
+		}
+
+		case UPLOAD_END:
+		{
+			if (n != 2 || !uploadLength || received != tileBytes(uploadLength))
+				return refuse();
+			uint16_t crc = crc16(0xffff, page() + UPLOAD_HEADER, received);
+			if (crc != get16(payload))
+			{
+				uploadLength = 0;
+				return refuse();
+			}
+			if (pageValid())
+			{
+				// Sent again: the level is already in
+				reply("OK", received);
+				return UPLOAD_IDLE;
+			}
+			uint16_t check = (uint16_t)~uploadLength;
+			uint8_t header[UPLOAD_HEADER] = {
+				(uint8_t)UPLOAD_MAGIC, (uint8_t)(UPLOAD_MAGIC >> 8), (uint8_t)uploadLength, (uint8_t)(uploadLength >> 8),
+				(uint8_t)check, (uint8_t)(check >> 8), (uint8_t)crc, (uint8_t)(crc >> 8)
+			};
+			// Magic last, so the level isn't there until it all is
+			if (!flashProgram(FLASH_LEVEL_FIRST, 2, header + 2, UPLOAD_HEADER - 2) || !flashProgram(FLASH_LEVEL_FIRST, 0, header, 2))
+			{
+				uploadLength = 0;
+				return refuse();
+			}
+			mapLevel(uploadLength);
+			reply("OK", received);
+			return UPLOAD_DONE;
+		}
+
+		default:
+			return refuse();
+	}
+}
+
+int uploadPoll(uint32_t budgetUs)
+{
+	uint8_t *frame = arena.mode.menu.uploadFrame;
+	int event = UPLOAD_IDLE;
+	for (;;)
+	{
+		// The rest isn't coming, or the menu was left with it half in (and
+		// the arena handed over): look for the next sync
+		if (frameLen && micros() - frameStart > UPLOAD_FRAME_TIMEOUT_US)
+			frameLen = 0;
+		// Still coming in?
+		if (frameLen < FRAME_HEAD || frameLen < FRAME_HEAD + frame[2] + 2)
+		{
+			int c = serialRead();
+			if (c < 0)
+				return event;
+			if (!frameLen)
+			{
+				if (c != UPLOAD_SYNC)
+					continue;
+				frameStart = micros();
+			}
+			frame[frameLen++] = (uint8_t)c;
+			if (frameLen == FRAME_HEAD && frame[2] > UPLOAD_PAYLOAD)
+			{
+				frameLen = 0;
+				reply("BAD", -1);
+			}
+			continue;
+		}
+		uint8_t n = frame[2];
+		if (get16(frame + FRAME_HEAD + n) != crc16(0xffff, frame + 1, (uint16_t)(n + 2)))
+		{
+			frameLen = 0;
+			reply("BAD", -1);
+			continue;
+		}
+		uint32_t cost = frameCost(frame);
+		if (cost > budgetUs)
+			return event; // the frame waits for next time
+		budgetUs -= cost;
+		int e = handleFrame(frame);
+		frameLen = 0;
+		if (e != UPLOAD_IDLE)
+			event = e;
+	}
+}
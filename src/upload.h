@@ -0,0 +1,71 @@
+#ifndef UPLOAD_H
+#define UPLOAD_H
+#include <stdint.h>
+#include "flash.h"
+#include "levels.h"
+
+// ============================================
+// LEVEL UPLOAD
+// A level sent over the serial port (tools/level_upload.py) goes into the
+// flash page reserved for it (flash.h) and becomes level LEVEL_UPLOADED.
+// There's one such level; the next upload replaces it.
+//
+// Frames from the host (little endian):
+//   0    u8   UPLOAD_SYNC
+//   1    u8   type (UPLOAD_BEGIN, UPLOAD_DATA, UPLOAD_END)
+//   2    u8   payload length n, at most UPLOAD_PAYLOAD
+//   3    n    payload
+//   3+n  u16  CRC-16 (crc.h) of bytes 1..2+n
+// Payloads:
+//   UPLOAD_BEGIN  u16 length (columns), u8 rows (must be LEVEL_ROWS)
+//   UPLOAD_DATA   u16 offset, then up to UPLOAD_CHUNK tile bytes
+//   UPLOAD_END    u16 CRC-16 of all the tile bytes
+// The tile bytes are the rows back to back, row 0 first (the layout of
+// level files, src/host/level_file.h), sent in order in even-sized chunks
+// (the last may be odd).
+//
+// The device answers each frame with a line:
+//   "UPLOAD OK <n>"  done; n is how many tile bytes it has so far
+//   "UPLOAD BAD"     the frame was damaged: send it again
+//   "UPLOAD NO"      refused (too long, out of order, or the data didn't
+//                    check out): start again from UPLOAD_BEGIN
+// and the host waits for the answer before sending the next frame.  That
+// matters: the core stalls while flash is busy, and serial bytes arriving
+// then are lost.  Sending a frame again after a lost answer is harmless.
+//
+// The page holds
+//   0   u16  magic, written last
+//   2   u16  length, 4 u16 ~length, 6 u16 CRC-16 of the tile bytes
+//   8        tile bytes
+// so an upload cut short by a reset leaves no level rather than half of
+// one.  Frames are only taken from the menu, where the flash work can't
+// be seen, and are put together in the arena's menu overlay (arena.h): a
+// frame the menu is left in the middle of is thrown away.
+// ============================================
+#define UPLOAD_SYNC 0x5a
+#define UPLOAD_BEGIN 'B'
+#define UPLOAD_DATA 'D'
+#define UPLOAD_END 'E'
+#define UPLOAD_CHUNK 32
+#define UPLOAD_PAYLOAD (2 + UPLOAD_CHUNK)
+#define UPLOAD_FRAME_MAX (3 + UPLOAD_PAYLOAD + 2)
+#define UPLOAD_HEADER 8
+#define UPLOAD_MAX_LENGTH ((FLASH_PAGE_BYTES - UPLOAD_HEADER) / LEVEL_ROWS)
+// A frame that stops arriving for this long is thrown away
+#define UPLOAD_FRAME_TIMEOUT_US 100000
+
+// What uploadPoll did
+enum {
+	UPLOAD_IDLE,
+	UPLOAD_CLEARED,  // a new upload started: the old level is gone
+	UPLOAD_DONE      // LEVEL_UPLOADED is the new level
+};
+
+// Put a previously uploaded level in the table.  Call flashInit first.
+void uploadInit(void);
+// Take what's arrived on the serial port, stopping before the flash work
+// would take longer than budgetUs at worst.  An erase needs FLASH_ERASE_US
+// in one go.
+int uploadPoll(uint32_t budgetUs);
+
+#endif
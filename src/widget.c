@@ -0,0 +1,293 @@
+#include "widget.h"
+#include "display.h"
+#include "font5x7.h"
+
+// More changes than this in one update are merged into fewer, larger
+// rectangles
+#define MAX_DIRTY 4
+// A rectangle is worth its own aperture only if merging it would send
+// more pixels than an aperture costs (11 bus bytes, about 6 pixels)
+#define APERTURE_PIXELS 6
+
+typedef struct {
+	int16_t x1, y1, x2, y2; // exclusive right and bottom
+} Rect;
+
+static Widget *widgets;
+static uint8_t numWidgets;
+static const uint16_t *bgPalette;
+static const uint8_t *bgRuns;
+static uint16_t bgFill;
+static Rect dirty[MAX_DIRTY];
+static uint8_t numDirty;
+
+static int32_t area(const Rect *r)
+{
+	return (int32_t)(r->x2 - r->x1) * (r->y2 - r->y1);
+}
+static Rect join(const Rect *a, const Rect *b)
+{
+	Rect r;
+	r.x1 = a->x1 < b->x1 ? a->x1 : b->x1;
+	r.y1 = a->y1 < b->y1 ? a->y1 : b->y1;
+	r.x2 = a->x2 > b->x2 ? a->x2 : b->x2;
+	r.y2 = a->y2 > b->y2 ? a->y2 : b->y2;
+	return r;
+}
+static int overlaps(const Rect *a, const Rect *b)
+{
+	return a->x1 < b->x2 && b->x1 < a->x2 && a->y1 < b->y2 && b->y1 < a->y2;
+}
+static int contains(const Rect *outer, const Rect *inner)
+{
+	return outer->x1 <= inner->x1 && outer->y1 <= inner->y1 && outer->x2 >= inner->x2 && outer->y2 >= inner->y2;
+}
+// Cheaper sent as one than as two?
+static int worthMerging(const Rect *a, const Rect *b)
+{
+	Rect u = join(a, b);
+	return overlaps(a, b) || area(&u) <= area(a) + area(b) + APERTURE_PIXELS;
+}
+
+static Rect bounds(const Widget *w)
+{
+	Rect r;
+	int width = w->w, height = w->h;
+	int len = 0;
+	switch (w->kind)
+	{
+		case WIDGET_TEXT:
+			while (w->value.text[len]) len++;
+			width = len ? len * (FONT_WIDTH * w->scale + 2) - 2 : 0;
+			height = FONT_HEIGHT * w->scale;
+			break;
+		case WIDGET_NUMBER:
+			width = 5 * (FONT_WIDTH + 2) - 2;
+			height = FONT_HEIGHT;
+			break;
+		case WIDGET_ARROW:
+			width = w->dir == ARROW_DOWN ? 9 : 5;
+			height = w->dir == ARROW_DOWN ? 5 : 9;
+			break;
+	}
+	r.x1 = w->x;
+	r.y1 = w->y;
+	r.x2 = (int16_t)(w->x + width);
+	r.y2 = (int16_t)(w->y + height);
+	return r;
+}
+
+// Fold rectangle n into any other it's worth merging with, and the result
+// again, until nothing more merges
+static void settle(int n)
+{
+	int merged = 1;
+	while (merged)
+	{
+		merged = 0;
+		for (int i = 0; i < numDirty; i++)
+		{
+			if (i != n && worthMerging(&dirty[i], &dirty[n]))
+			{
+				dirty[i] = join(&dirty[i], &dirty[n]);
+				dirty[n] = dirty[--numDirty];
+				n = (i == numDirty) ? n : i;
+				merged = 1;
+				break;
+			}
+		}
+	}
+}
+
+static void addDirty(Rect r)
+{
+	if (r.x1 < 0) r.x1 = 0;
+	if (r.y1 < 0) r.y1 = 0;
+	if (r.x2 > SCREEN_WIDTH) r.x2 = SCREEN_WIDTH;
+	if (r.y2 > SCREEN_HEIGHT) r.y2 = SCREEN_HEIGHT;
+	if (r.x1 >= r.x2 || r.y1 >= r.y2)
+		return;
+	if (numDirty == MAX_DIRTY)
+	{
+		// Full: grow whichever rectangle takes it in most cheaply
+		int best = 0;
+		int32_t bestGrowth = 0;
+		for (int i = 0; i < numDirty; i++)
+		{
+			Rect u = join(&dirty[i], &r);
+			int32_t growth = area(&u) - area(&dirty[i]);
+			if (i == 0 || growth < bestGrowth)
+			{
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+		dirty[best] = join(&dirty[best], &r);
+		settle(best);
+		return;
+	}
+	dirty[numDirty] = r;
+	settle(numDirty++);
+}
+
+// Shown widgets' areas go dirty around every change
+static void touch(const Widget *w)
+{
+	if (w->flags & WIDGET_SHOWN)
+		addDirty(bounds(w));
+}
+
+void widgetScreen(Widget *list, uint8_t count, const uint16_t *palette, const uint8_t *runs, uint16_t fill)
+{
+	widgets = list;
+	numWidgets = count;
+	bgPalette = palette;
+	bgRuns = runs;
+	bgFill = fill;
+	numDirty = 0;
+}
+void widgetInvalidate(int x, int y, int w, int h)
+{
+	Rect r;
+	r.x1 = (int16_t)x;
+	r.y1 = (int16_t)y;
+	r.x2 = (int16_t)(x + w);
+	r.y2 = (int16_t)(y + h);
+	addDirty(r);
+}
+
+void widgetSetText(Widget *w, const char *text)
+{
+	if (w->value.text == text)
+		return;
+	touch(w);
+	w->value.text = text;
+	touch(w);
+}
+void widgetSetNumber(Widget *w, uint16_t number)
+{
+	if (w->value.number == number)
+		return;
+	w->value.number = number;
+	touch(w);
+}
+void widgetSetSprite(Widget *w, const uint16_t *sprite)
+{
+	if (w->value.sprite == sprite)
+		return;
+	w->value.sprite = sprite;
+	touch(w);
+}
+void widgetSetColour(Widget *w, uint16_t colour)
+{
+	if (w->colour == colour)
+		return;
+	w->colour = colour;
+	touch(w);
+}
+void widgetShow(Widget *w, int shown)
+{
+	if (!(w->flags & WIDGET_SHOWN) == !shown)
+		return;
+	touch(w);
+	w->flags ^= WIDGET_SHOWN;
+	touch(w);
+}
+
+static void drawArrow(const Widget *w)
+{
+	for (int i = 0; i < 5; i++)
+	{
+		if (w->dir == ARROW_LEFT)
+			drawLine((uint16_t)(w->x + i), (uint16_t)(w->y + i), (uint16_t)(w->x + i), (uint16_t)(w->y + 8 - i), w->colour);
+		else if (w->dir == ARROW_RIGHT)
+			drawLine((uint16_t)(w->x + 4 - i), (uint16_t)(w->y + i), (uint16_t)(w->x + 4 - i), (uint16_t)(w->y + 8 - i), w->colour);
+		else
+			drawLine((uint16_t)(w->x + i), (uint16_t)(w->y + 4 - i), (uint16_t)(w->x + 8 - i), (uint16_t)(w->y + 4 - i), w->colour);
+	}
+}
+static void drawWidget(const Widget *w)
+{
+	switch (w->kind)
+	{
+		case WIDGET_TEXT:
+			if (w->scale == 2)
+				printTextX2(w->value.text, w->x, w->y, w->colour, w->back);
+			else
+				printText(w->value.text, w->x, w->y, w->colour, w->back);
+			break;
+		case WIDGET_NUMBER:
+			printNumber(w->value.number, w->x, w->y, w->colour, w->back);
+			break;
+		case WIDGET_SPRITE:
+			putImage(w->x, w->y, w->w, w->h, w->value.sprite, 0, 0);
+			break;
+		case WIDGET_RECT:
+			fillRectangle(w->x, w->y, w->w, w->h, w->colour);
+			break;
+		default:
+			drawArrow(w);
+			break;
+	}
+}
+
+// Sprites and rects cover every pixel of their bounds; text leaves the
+// gaps between glyphs and arrows are only lines
+static int opaque(const Widget *w)
+{
+	return w->kind == WIDGET_SPRITE || w->kind == WIDGET_RECT;
+}
+
+int widgetUpdate(void)
+{
+	// Grow each rectangle over the widgets it cuts into, as those have to
+	// be drawn whole, until none is cut into any more
+	int grown = 1;
+	while (grown)
+	{
+		grown = 0;
+		for (int d = 0; d < numDirty && !grown; d++)
+		{
+			for (int i = 0; i < numWidgets; i++)
+			{
+				Rect b = bounds(&widgets[i]);
+				if ((widgets[i].flags & WIDGET_SHOWN) && overlaps(&b, &dirty[d]) && !contains(&dirty[d], &b))
+				{
+					dirty[d] = join(&dirty[d], &b);
+					settle(d);
+					grown = 1;
+					break;
+				}
+			}
+		}
+	}
+
+	int sent = numDirty;
+	for (int d = 0; d < numDirty; d++)
+	{
+		const Rect *r = &dirty[d];
+		// The background only shows if no opaque widget covers the lot
+		int covered = 0;
+		for (int i = 0; i < numWidgets && !covered; i++)
+		{
+			Rect b = bounds(&widgets[i]);
+			covered = (widgets[i].flags & WIDGET_SHOWN) && opaque(&widgets[i]) && contains(&b, r);
+		}
+		if (!covered)
+		{
+			if (bgRuns)
+				putImageRLEWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, bgPalette, bgRuns, (uint16_t)r->x1, (uint16_t)r->y1,
+					(uint16_t)(r->x2 - r->x1), (uint16_t)(r->y2 - r->y1));
+			else
+				fillRectangle((uint16_t)r->x1, (uint16_t)r->y1, (uint16_t)(r->x2 - r->x1), (uint16_t)(r->y2 - r->y1), bgFill);
+		}
+		for (int i = 0; i < numWidgets; i++)
+		{
+			Rect b = bounds(&widgets[i]);
+			if ((widgets[i].flags & WIDGET_SHOWN) && overlaps(&b, r))
+				drawWidget(&widgets[i]);
+		}
+	}
+	numDirty = 0;
+	return sent;
+}
@@ -0,0 +1,61 @@
+#ifndef WIDGET_H
+#define WIDGET_H
+#include <stdint.h>
+
+// ============================================
+// RETAINED WIDGETS
+// A screen is a background (a palette+RLE layer from ui_images.h, or a
+// plain fill) with a short list of widgets over it, drawn in list order.
+// Setting a widget's value only records the change: the area it covered
+// and the area it covers now go into a small set of dirty rectangles,
+// merged where one aperture is cheaper than two, and widgetUpdate redraws
+// just those.  A rectangle is first grown to take in every widget it
+// touches, since text and sprites can only be drawn whole, then gets the
+// background (clipped to it) and those widgets on top.
+//
+// The widget list belongs to the caller, so a screen can keep it wherever
+// it has room (the menus use the arena's menu overlay).
+// ============================================
+enum {
+	WIDGET_TEXT,   // text, printText or printTextX2 (scale 2)
+	WIDGET_NUMBER, // number, five digits as printNumber draws it
+	WIDGET_SPRITE, // sprite, w x h
+	WIDGET_RECT,   // filled w x h in colour
+	WIDGET_ARROW   // arrow pointing dir, as on the menus
+};
+enum { ARROW_LEFT, ARROW_RIGHT, ARROW_DOWN };
+
+#define WIDGET_SHOWN 1 // flags
+
+typedef struct {
+	uint8_t kind;
+	uint8_t flags;
+	uint8_t x, y;
+	uint8_t w, h;   // sprite and rect size; the rest work theirs out
+	uint8_t scale;  // text
+	uint8_t dir;    // arrow
+	uint16_t colour;
+	uint16_t back;  // text and number
+	union {
+		const char *text;
+		const uint16_t *sprite;
+		uint16_t number;
+	} value;
+} Widget;
+
+// Take over a widget list.  Nothing is drawn: invalidate the whole screen
+// to put it all up, or leave what's there (a label over the playfield).
+void widgetScreen(Widget *widgets, uint8_t count, const uint16_t *palette, const uint8_t *runs, uint16_t fill);
+void widgetInvalidate(int x, int y, int w, int h);
+
+// Each marks the widget dirty only if the value actually changes
+void widgetSetText(Widget *w, const char *text);
+void widgetSetNumber(Widget *w, uint16_t number);
+void widgetSetSprite(Widget *w, const uint16_t *sprite);
+void widgetSetColour(Widget *w, uint16_t colour);
+void widgetShow(Widget *w, int shown);
+
+// Redraw what changed; returns the number of rectangles sent
+int widgetUpdate(void);
+
+#endif
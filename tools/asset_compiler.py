@@ -0,0 +1,616 @@
+"""Asset compiler: turns the images in assets/ into the sprite and level
+sources the firmware is built from.
+
+Usage:
+    python tools/asset_compiler.py [--project .] [--cache file] [--force]
+
+Sources:
+- assets/sprites/<name>.png|.bmp: a sprite called <name> in C, stored as
+  RGB565 words in the panel's byte order (RGBToWord). Pixels less than half
+  opaque are stored as 0.
+- assets/levels/level_<n>.png|.bmp: level n, LEVEL_ROWS pixels high and one
+  pixel per column, bottom row = row 0. Black is empty, red a spike, blue a
+  block and yellow a jump pad; other colours go to the nearest of those.
+- assets/ui/<name>_<W>x<H>.png|.bmp: a pre-rendered UI layer for screens
+  W by H pixels, at most 16 colours. Stored as a palette plus run lengths
+  (see putImageRLE in src/display.h), so it costs a few hundred bytes of
+  flash instead of 40 KB. Every name needs an image for every screen size
+  that has any.
+
+Outputs (rewritten only when their text changes, so the build only
+recompiles what an asset change actually touched):
+- src/sprite_map.h, src/sprite_map.c: every sprite in one array,
+  spritePixels, with offset and size macros per sprite and the old names
+  (mainChar, ...) as pointers into it
+- src/levels/level_data.h: every level row in one array, levelTiles, and
+  the LevelInfo initialisers levels.c builds its table from
+- src/ui_images.h, src/ui_images.c: the UI layers for the screen size being
+  built, palettes in uiPalette and runs in uiRLE, with offset and size
+  macros per image
+- src/asset_manifest.json: what went where, for tools/size_budget.py
+
+Identical sprites, level rows, palettes and run streams are stored once, and an item whose start
+matches the end of the one before it in the array overlaps it, so a row
+of empty columns often costs nothing. Decoded images are cached by content
+hash (--cache, default .pio/asset_cache.json), so only changed images are
+decoded again; if no source has changed since the manifest was written,
+nothing is done at all.
+
+Runs before every PlatformIO build through tools/pio_assets.py. Exit
+status is 1 if an asset can't be read.
+"""
+import argparse
+import hashlib
+import json
+import os
+import re
+import struct
+import sys
+import zlib
+
+TILE_COLOURS = {
+    (0, 0, 0): 0,        # empty
+    (255, 0, 0): 1,      # spike
+    (0, 0, 255): 2,      # block
+    (255, 255, 0): 3,    # jump pad
+}
+IMAGE_EXTENSIONS = (".png", ".bmp")
+UI_COLOURS = 16          # palette entries a UI image can use
+UI_RUN_SHORT = 15        # longest run a single byte holds
+UI_RUN_LONG = 16 + 255   # longest run with the extension byte
+GENERATED = "Generated by tools/asset_compiler.py"
+
+
+class AssetError(Exception):
+    pass
+
+
+# --- image readers --------------------------------------------------------
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data):
+    """8 bit grey, grey+alpha, RGB, RGBA or palette PNGs, not interlaced.
+    Returns (width, height, [(r, g, b, a), ...])."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise AssetError("not a PNG")
+    pos = 8
+    idat = []
+    palette = []
+    alphas = b""
+    header = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            alphas = body
+        elif kind == b"IDAT":
+            idat.append(body)
+        elif kind == b"IEND":
+            break
+    if header is None:
+        raise AssetError("PNG has no header")
+    width, height, depth, colour, _, _, interlace = header
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(colour)
+    if depth != 8 or channels is None or interlace:
+        raise AssetError("only 8 bit, non-interlaced PNGs are supported")
+    raw = zlib.decompress(b"".join(idat))
+    stride = width * channels
+    prev = bytearray(stride)
+    pixels = []
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for x in range(stride):
+            a = line[x - channels] if x >= channels else 0
+            b = prev[x]
+            c = prev[x - channels] if x >= channels else 0
+            if kind == 1:
+                line[x] = (line[x] + a) & 255
+            elif kind == 2:
+                line[x] = (line[x] + b) & 255
+            elif kind == 3:
+                line[x] = (line[x] + ((a + b) >> 1)) & 255
+            elif kind == 4:
+                line[x] = (line[x] + paeth(a, b, c)) & 255
+        for x in range(0, stride, channels):
+            px = line[x:x + channels]
+            if colour == 0:
+                pixels.append((px[0], px[0], px[0], 255))
+            elif colour == 2:
+                pixels.append((px[0], px[1], px[2], 255))
+            elif colour == 3:
+                r, g, b = palette[px[0]]
+                pixels.append((r, g, b, alphas[px[0]] if px[0] < len(alphas) else 255))
+            elif colour == 4:
+                pixels.append((px[0], px[0], px[0], px[1]))
+            else:
+                pixels.append(tuple(px))
+        prev = line
+    return width, height, pixels
+
+
+def read_bmp(data):
+    """Uncompressed 24 or 32 bit BMPs."""
+    if data[:2] != b"BM":
+        raise AssetError("not a BMP")
+    offset = struct.unpack("<I", data[10:14])[0]
+    width, height, _, bits, compression = struct.unpack("<iiHHI", data[18:34])
+    if bits not in (24, 32) or compression not in (0, 3):
+        raise AssetError("only uncompressed 24 and 32 bit BMPs are supported")
+    step = bits // 8
+    stride = (width * step + 3) & ~3
+    rows = []
+    for y in range(abs(height)):
+        base = offset + y * stride
+        rows.append([(data[base + x * step + 2], data[base + x * step + 1], data[base + x * step], 255)
+                     for x in range(width)])
+    if height > 0:
+        rows.reverse()  # stored bottom up
+    return width, abs(height), [px for row in rows for px in row]
+
+
+def read_image(path):
+    with open(path, "rb") as fh:
+        data = fh.read()
+    try:
+        return read_png(data) if path.lower().endswith(".png") else read_bmp(data)
+    except (AssetError, struct.error, zlib.error, IndexError) as e:
+        raise AssetError("%s: %s" % (path, e))
+
+
+# --- conversions ----------------------------------------------------------
+
+def rgb_to_word(r, g, b):
+    # Same as RGBToWord in display.c: RGB565 with the bytes swapped, except
+    # that the green bits in the top byte are G's lowest three
+    return ((g >> 5) + ((g & 7) << 13) + ((r >> 3) << 8) + ((b >> 3) << 3)) & 0xffff
+
+
+def closest_tile(r, g, b):
+    return min(TILE_COLOURS.items(),
+               key=lambda kv: sum((p - q) ** 2 for p, q in zip(kv[0], (r, g, b))))[1]
+
+
+def convert_sprite(path):
+    width, height, pixels = read_image(path)
+    words = [rgb_to_word(r, g, b) if a >= 128 else 0 for r, g, b, a in pixels]
+    return {"width": width, "height": height, "data": words}
+
+
+def convert_level(path, rows):
+    width, height, pixels = read_image(path)
+    if height != rows:
+        raise AssetError("%s: %d pixels high, levels have %d rows" % (path, height, rows))
+    tiles = []
+    for row in range(rows):
+        y = rows - 1 - row  # bottom of the image is row 0
+        tiles.append([closest_tile(*pixels[y * width + x][:3]) for x in range(width)])
+    return {"width": width, "height": height, "data": tiles}
+
+
+def convert_ui(path):
+    """Palette (most used colour first) and runs: one byte per run, the
+    palette index in the low nibble and the length less one in the high
+    nibble; a high nibble of 15 means 16 plus the byte that follows."""
+    width, height, pixels = read_image(path)
+    words = [rgb_to_word(r, g, b) for r, g, b, _ in pixels]
+    counts = {}
+    for w in words:
+        counts[w] = counts.get(w, 0) + 1
+    if len(counts) > UI_COLOURS:
+        raise AssetError("%s: %d colours, UI images can have %d" % (path, len(counts), UI_COLOURS))
+    palette = sorted(counts, key=lambda w: (-counts[w], w))
+    index = {w: i for i, w in enumerate(palette)}
+    rle = []
+    pos = 0
+    while pos < len(words):
+        end = pos
+        while end < len(words) and words[end] == words[pos] and end - pos < UI_RUN_LONG:
+            end += 1
+        n = end - pos
+        if n <= UI_RUN_SHORT:
+            rle.append((n - 1) << 4 | index[words[pos]])
+        else:
+            rle += [0xf0 | index[words[pos]], n - 16]
+        pos = end
+    return {"width": width, "height": height, "palette": palette, "rle": rle}
+
+
+# --- pooling --------------------------------------------------------------
+
+class Pool:
+    """One array holding many items. An item already in the array (as a
+    whole or inside another) is not stored again, and a new item overlaps
+    as much of the array's tail as matches its head."""
+
+    def __init__(self):
+        self.data = []
+        self.items = []  # (name, offset, length)
+
+    def add_all(self, named):
+        # Longest first, so shorter items land inside longer ones
+        for name, values in sorted(named, key=lambda nv: -len(nv[1])):
+            self.items.append((name, self.place(list(values)), len(values)))
+        self.items.sort(key=lambda item: (item[1], item[0]))
+
+    def place(self, values):
+        n = len(values)
+        for start in range(len(self.data) - n + 1):
+            if self.data[start:start + n] == values:
+                return start
+        for overlap in range(min(n, len(self.data)) - 1, 0, -1):
+            if self.data[-overlap:] == values[:overlap]:
+                start = len(self.data) - overlap
+                self.data.extend(values[overlap:])
+                return start
+        start = len(self.data)
+        self.data.extend(values)
+        return start
+
+    def offset(self, name):
+        return next(offset for n, offset, _ in self.items if n == name)
+
+
+# --- output ---------------------------------------------------------------
+
+def macro_name(name):
+    return re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", name).upper()
+
+
+def pool_lines(pool, per_line, width, label):
+    """Array body, a comment line wherever an item starts."""
+    starts = {}
+    for name, offset, _ in pool.items:
+        starts.setdefault(offset, []).append(name)
+    lines = []
+    line = []
+    for i, value in enumerate(pool.data):
+        if i in starts or len(line) == per_line:
+            if line:
+                lines.append("\t" + ",".join(line) + ",")
+                line = []
+            if i in starts:
+                lines.append("\t// " + ", ".join(label(n) for n in starts[i]))
+        line.append(str(value).rjust(width))
+    if line:
+        lines.append("\t" + ",".join(line) + ",")
+    return lines
+
+
+def sprite_sources(sprites, pool):
+    header = [
+        "#ifndef SPRITES_H",
+        "#define SPRITES_H",
+        "// %s from assets/sprites/; edit the images, not this file." % GENERATED,
+        "",
+        "#include <stdint.h>",
+        "",
+        "// Every sprite is RGB565 in the panel's byte order, row by row.  They",
+        "// all live in spritePixels (sprite_map.c); identical sprites share words.",
+        "#define SPRITE_PIXELS %d" % len(pool.data),
+        "extern const uint16_t spritePixels[SPRITE_PIXELS];",
+    ]
+    for name in sorted(sprites):
+        m = "SPRITE_" + macro_name(name)
+        header += [
+            "",
+            "#define %s_OFFSET %d" % (m, pool.offset(name)),
+            "#define %s_WIDTH %d" % (m, sprites[name]["width"]),
+            "#define %s_HEIGHT %d" % (m, sprites[name]["height"]),
+            "#define %s (spritePixels + %s_OFFSET)" % (name, m),
+        ]
+    header += ["", "#endif // SPRITES_H", ""]
+    body = [
+        "// %s from assets/sprites/; edit the images, not this file." % GENERATED,
+        '#include "sprite_map.h"',
+        "",
+        "const uint16_t spritePixels[SPRITE_PIXELS] = {",
+    ]
+    body += pool_lines(pool, 16, 5,
+                       lambda n: "%s (%dx%d)" % (n, sprites[n]["width"], sprites[n]["height"]))
+    body += ["};", ""]
+    return "\n".join(header), "\n".join(body)
+
+
+def level_source(levels, pool, rows):
+    out = [
+        "#ifndef LEVEL_DATA_H",
+        "#define LEVEL_DATA_H",
+        "// %s from assets/levels/; edit the images, not this file." % GENERATED,
+        "// Included by levels.c only.",
+        "",
+        "#include <stdint.h>",
+        "",
+        "// Every level row lives in levelTiles; identical rows, and runs shared",
+        "// between the end of one row and the start of the next, are stored once.",
+        "#define LEVEL_COUNT %d" % len(levels),
+        "#define LEVEL_TILES %d" % len(pool.data),
+        "",
+    ]
+    for n in range(len(levels)):
+        row_ptrs = ", ".join("levelTiles + %d" % pool.offset("level %d row %d" % (n, r)) for r in range(rows))
+        out.append("#define LEVEL_%d_LENGTH %d" % (n, levels[n]["width"]))
+        out.append("#define LEVEL_%d_INFO { { %s }, LEVEL_%d_LENGTH }" % (n, row_ptrs, n))
+    out.append("#define LEVEL_TABLE %s" % ", ".join("LEVEL_%d_INFO" % n for n in range(len(levels))))
+    out += ["", "const uint8_t levelTiles[LEVEL_TILES] = {"]
+    out += pool_lines(pool, 20, 1, lambda n: n)
+    out += ["};", "", "#endif", ""]
+    return "\n".join(out)
+
+
+def ui_sources(ui, palettes, runs):
+    """ui maps (width, height) to {name: image}; palettes and runs hold a
+    Pool per screen size. Only the block for the size being built is
+    compiled."""
+    sizes = sorted(ui)
+    header = [
+        "#ifndef UI_IMAGES_H",
+        "#define UI_IMAGES_H",
+        "// %s from assets/ui/; edit the images, not this file." % GENERATED,
+        "",
+        "#include <stdint.h>",
+        '#include "display_config.h"',
+        "",
+        "// Full-screen UI layers as a palette and run lengths each, drawn with",
+        "// putImageRLE.  Palettes live in uiPalette and runs in uiRLE",
+        "// (ui_images.c); identical palettes and runs are stored once.",
+    ]
+    body = [
+        "// %s from assets/ui/; edit the images, not this file." % GENERATED,
+        '#include "ui_images.h"',
+    ]
+    for i, size in enumerate(sizes):
+        cond = "#%s SCREEN_WIDTH == %d && SCREEN_HEIGHT == %d" % ("if" if i == 0 else "elif", size[0], size[1])
+        header += [cond,
+                   "#define UI_PALETTE_WORDS %d" % len(palettes[size].data),
+                   "#define UI_RLE_BYTES %d" % len(runs[size].data)]
+        for name in sorted(ui[size]):
+            m = "UI_" + macro_name(name)
+            ptr = "ui" + name[:1].upper() + name[1:]
+            header += [
+                "#define %s_WIDTH %d" % (m, ui[size][name]["width"]),
+                "#define %s_HEIGHT %d" % (m, ui[size][name]["height"]),
+                "#define %s_PALETTE_OFFSET %d" % (m, palettes[size].offset(name)),
+                "#define %s_RLE_OFFSET %d" % (m, runs[size].offset(name)),
+                "#define %sPalette (uiPalette + %s_PALETTE_OFFSET)" % (ptr, m),
+                "#define %sRLE (uiRLE + %s_RLE_OFFSET)" % (ptr, m),
+            ]
+        label = lambda n: "%s (%dx%d)" % (n, size[0], size[1])
+        body += [
+            "",
+            cond,
+            "const uint16_t uiPalette[UI_PALETTE_WORDS] = {",
+        ] + pool_lines(palettes[size], 8, 5, label) + [
+            "};",
+            "const uint8_t uiRLE[UI_RLE_BYTES] = {",
+        ] + pool_lines(runs[size], 20, 3, label) + [
+            "};",
+        ]
+    if sizes:
+        header += ["#else",
+                   '#error "No UI images for this screen size: add assets/ui/<name>_<width>x<height>.png"',
+                   "#endif",
+                   "",
+                   "extern const uint16_t uiPalette[UI_PALETTE_WORDS];",
+                   "extern const uint8_t uiRLE[UI_RLE_BYTES];"]
+        body += ["#endif"]
+    header += ["", "#endif // UI_IMAGES_H", ""]
+    body += [""]
+    return "\n".join(header), "\n".join(body)
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as fh:
+            if fh.read() == text:
+                return False
+    except OSError:
+        pass
+    with open(path, "w") as fh:
+        fh.write(text)
+    return True
+
+
+# --- driver ---------------------------------------------------------------
+
+def file_hash(path):
+    with open(path, "rb") as fh:
+        return hashlib.sha1(fh.read()).hexdigest()
+
+
+def find_sources(assets):
+    sprites = {}
+    levels = {}
+    ui = {}
+    sprite_dir = os.path.join(assets, "sprites")
+    level_dir = os.path.join(assets, "levels")
+    ui_dir = os.path.join(assets, "ui")
+    for d, into, pattern in ((sprite_dir, sprites, r"^([A-Za-z_]\w*)$"), (level_dir, levels, r"^level_(\d+)$"),
+                             (ui_dir, ui, r"^([A-Za-z]\w*?)_(\d+)x(\d+)$")):
+        if not os.path.isdir(d):
+            continue
+        for f in sorted(os.listdir(d)):
+            stem, ext = os.path.splitext(f)
+            m = re.match(pattern, stem)
+            if ext.lower() in IMAGE_EXTENSIONS and m:
+                if into is levels:
+                    key = int(m.group(1))
+                elif into is ui:
+                    key = (m.group(1), int(m.group(2)), int(m.group(3)))
+                else:
+                    key = m.group(1)
+                if key in into:
+                    raise AssetError("%s and %s are the same asset" % (into[key], os.path.join(d, f)))
+                into[key] = os.path.join(d, f)
+    if sorted(levels) != list(range(len(levels))):
+        raise AssetError("levels must be numbered from 0 with no gaps, found %s" % sorted(levels))
+    names = set(name for name, _, _ in ui)
+    for size in set((w, h) for _, w, h in ui):
+        missing = sorted(n for n in names if (n,) + size not in ui)
+        if missing:
+            raise AssetError("no %dx%d image for UI layer%s %s" % (size + ("" if len(missing) == 1 else "s",
+                                                                         ", ".join(missing))))
+    return sprites, levels, ui
+
+
+def level_rows(src):
+    with open(os.path.join(src, "levels.h")) as fh:
+        m = re.search(r"#define\s+LEVEL_ROWS\s+(\d+)", fh.read())
+    if not m:
+        raise AssetError("no LEVEL_ROWS in levels.h")
+    return int(m.group(1))
+
+
+def compile_assets(project, cache_path=None, force=False, log=print):
+    assets = os.path.join(project, "assets")
+    src = os.path.join(project, "src")
+    manifest_path = os.path.join(src, "asset_manifest.json")
+    outputs = [os.path.join(src, p) for p in ("sprite_map.h", "sprite_map.c", os.path.join("levels", "level_data.h"),
+                                              "ui_images.h", "ui_images.c")]
+
+    sprite_paths, level_paths, ui_paths = find_sources(assets)
+    rows = level_rows(src)
+    rel = lambda p: os.path.relpath(p, project).replace(os.sep, "/")
+    hashes = {rel(p): file_hash(p) for p in list(sprite_paths.values()) + list(level_paths.values())
+              + list(ui_paths.values())}
+    hashes[rel(os.path.abspath(__file__))] = file_hash(os.path.abspath(__file__))
+    hashes["LEVEL_ROWS"] = str(rows)
+
+    old = {}
+    try:
+        with open(manifest_path) as fh:
+            old = json.load(fh)
+    except (OSError, ValueError):
+        pass
+    if not force and old.get("sources") == hashes and all(os.path.exists(p) for p in outputs):
+        log("assets: up to date")
+        return 0
+
+    cache = {}
+    if cache_path:
+        try:
+            with open(cache_path) as fh:
+                cache = json.load(fh)
+        except (OSError, ValueError):
+            pass
+    decoded = 0
+
+    def load(path, convert):
+        nonlocal decoded
+        key = rel(path)
+        entry = cache.get(key)
+        if entry and entry["hash"] == hashes[key] and not force:
+            return entry["asset"]
+        asset = convert(path)
+        cache[key] = {"hash": hashes[key], "asset": asset}
+        decoded += 1
+        return asset
+
+    sprites = {name: load(p, convert_sprite) for name, p in sprite_paths.items()}
+    levels = [load(level_paths[n], lambda p: convert_level(p, rows)) for n in sorted(level_paths)]
+    ui = {}
+    for (name, w, h), p in ui_paths.items():
+        image = load(p, convert_ui)
+        if (image["width"], image["height"]) != (w, h):
+            raise AssetError("%s: %dx%d pixels, its name says %dx%d" % (p, image["width"], image["height"], w, h))
+        ui.setdefault((w, h), {})[name] = image
+
+    sprite_pool = Pool()
+    sprite_pool.add_all((name, s["data"]) for name, s in sprites.items())
+    level_pool = Pool()
+    level_pool.add_all(("level %d row %d" % (n, r), lvl["data"][r]) for n, lvl in enumerate(levels) for r in range(rows))
+    palette_pools = {}
+    rle_pools = {}
+    for size, images in ui.items():
+        palette_pools[size] = Pool()
+        palette_pools[size].add_all((name, image["palette"]) for name, image in images.items())
+        rle_pools[size] = Pool()
+        rle_pools[size].add_all((name, image["rle"]) for name, image in images.items())
+
+    header, body = sprite_sources(sprites, sprite_pool)
+    ui_header, ui_body = ui_sources(ui, palette_pools, rle_pools)
+    changed = [p for p, text in zip(outputs, (header, body, level_source(levels, level_pool, rows), ui_header, ui_body))
+               if write_if_changed(p, text)]
+
+    manifest = {
+        "generator": GENERATED,
+        "sources": hashes,
+        "pools": {
+            "spritePixels": {"module": "sprites", "bytes": 2 * len(sprite_pool.data),
+                             "unpooled_bytes": 2 * sum(len(s["data"]) for s in sprites.values())},
+            "levelTiles": {"module": "levels", "bytes": len(level_pool.data),
+                           "unpooled_bytes": sum(len(l["data"][r]) for l in levels for r in range(rows))},
+        },
+        "assets": [
+            {"name": name, "kind": "sprite", "source": rel(sprite_paths[name]), "pool": "spritePixels",
+             "offset": 2 * sprite_pool.offset(name), "bytes": 2 * len(sprites[name]["data"]),
+             "width": sprites[name]["width"], "height": sprites[name]["height"]}
+            for name in sorted(sprites)
+        ] + [
+            {"name": "level %d" % n, "kind": "level", "source": rel(level_paths[n]), "pool": "levelTiles",
+             "rows": [level_pool.offset("level %d row %d" % (n, r)) for r in range(rows)],
+             "bytes": rows * lvl["width"], "width": lvl["width"]}
+            for n, lvl in enumerate(levels)
+        ] + [
+            {"name": name, "kind": "ui", "source": rel(ui_paths[(name,) + size]), "pool": "uiRLE %dx%d" % size,
+             "offset": rle_pools[size].offset(name), "bytes": len(image["rle"]), "colours": len(image["palette"]),
+             "width": size[0], "height": size[1]}
+            for size in sorted(ui) for name, image in sorted(ui[size].items())
+        ],
+    }
+    # Only one screen size is built into the firmware, so each has its own pools
+    for size in sorted(ui):
+        images = ui[size].values()
+        manifest["pools"]["uiPalette %dx%d" % size] = {
+            "module": "ui_images", "bytes": 2 * len(palette_pools[size].data),
+            "unpooled_bytes": 2 * sum(len(i["palette"]) for i in images)}
+        manifest["pools"]["uiRLE %dx%d" % size] = {
+            "module": "ui_images", "bytes": len(rle_pools[size].data),
+            "unpooled_bytes": sum(len(i["rle"]) for i in images)}
+    write_if_changed(manifest_path, json.dumps(manifest, indent=1, sort_keys=True) + "\n")
+    if cache_path:
+        os.makedirs(os.path.dirname(os.path.abspath(cache_path)), exist_ok=True)
+        with open(cache_path, "w") as fh:
+            json.dump(cache, fh)
+
+    for name, pool in manifest["pools"].items():
+        log("assets: %s %d bytes (%d saved by sharing)" % (name, pool["bytes"], pool["unpooled_bytes"] - pool["bytes"]))
+    log("assets: %d image%s converted, %s" % (decoded, "" if decoded == 1 else "s",
+        ("rewrote " + ", ".join(rel(p) for p in changed)) if changed else "no source files changed"))
+    return 0
+
+
+def run(project, cache=None, force=False):
+    try:
+        return compile_assets(project, cache, force)
+    except (AssetError, OSError) as e:
+        print("assets: %s" % e)
+        return 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--project", default=".", help="project directory (holding assets/ and src/)")
+    ap.add_argument("--cache", default=os.path.join(".pio", "asset_cache.json"),
+                    help="decoded image cache, relative to the project")
+    ap.add_argument("--force", action="store_true", help="convert everything even if nothing changed")
+    args = ap.parse_args()
+    sys.exit(run(args.project, os.path.join(args.project, args.cache), args.force))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,168 @@
+"""Send a level to the board over its serial port (src/upload.h).
+
+Usage:
+    python level_upload.py <serial port> <level.png | level.bmp | level file> [--baud 115200]
+
+The level is an image like those in assets/levels/ (LEVEL_ROWS pixels high,
+one pixel per column) or a level file (src/host/level_file.h). The board
+takes it while it's on the menu, and it's the current level as soon as it's
+in: press DOWN to play it. It stays until the next upload replaces it.
+
+Uses pyserial if it's installed; otherwise the port is opened directly
+(POSIX only). The host stand-in, src/host/upload_main.c, prints a
+pseudo-terminal to send to instead of a board.
+"""
+import argparse
+import os
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import asset_compiler  # noqa: E402
+
+SYNC = 0x5A
+BEGIN = ord("B")
+DATA = ord("D")
+END = ord("E")
+CHUNK = 32
+HEADER = 8          # of the flash page
+PAGE_BYTES = 1024
+LEVEL_FILE_MAGIC = b"GDLV"
+
+REPLY_TIMEOUT = 0.5  # seconds; an erase takes 40 ms at worst
+TRIES = 20
+
+
+class UploadError(Exception):
+    pass
+
+
+def crc16(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def frame(kind, payload):
+    body = bytes([kind, len(payload)]) + payload
+    return bytes([SYNC]) + body + struct.pack("<H", crc16(body))
+
+
+def load_level(path, rows):
+    """The level's tile bytes, rows back to back from row 0, and its length."""
+    with open(path, "rb") as fh:
+        head = fh.read(12)
+        if head[:4] == LEVEL_FILE_MAGIC:
+            length, file_rows = struct.unpack("<II", head[4:12])
+            if file_rows != rows:
+                raise UploadError("%s: %d rows, levels have %d" % (path, file_rows, rows))
+            tiles = fh.read(length * rows)
+            if len(tiles) != length * rows:
+                raise UploadError("%s: cut short" % path)
+            return tiles, length
+    level = asset_compiler.convert_level(path, rows)
+    return bytes(t for row in level["data"] for t in row), level["width"]
+
+
+class Port:
+    def __init__(self, path, baud):
+        try:
+            import serial  # pyserial
+        except ImportError:
+            serial = None
+        if serial:
+            self.port = serial.Serial(path, baud, timeout=0)
+            self._write = self.port.write
+            self._read = lambda: self.port.read(256)
+        else:
+            import termios
+            import tty
+            fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+            tty.setraw(fd)
+            attrs = termios.tcgetattr(fd)
+            speed = getattr(termios, "B%d" % baud)
+            attrs[4] = attrs[5] = speed
+            termios.tcsetattr(fd, termios.TCSANOW, attrs)
+            self._write = lambda data: os.write(fd, data)
+            self._read = lambda: self._read_fd(fd)
+        self.pending = b""
+
+    @staticmethod
+    def _read_fd(fd):
+        try:
+            return os.read(fd, 256)
+        except BlockingIOError:
+            return b""
+
+    def write(self, data):
+        self._write(data)
+
+    def reply(self, timeout):
+        """The next "UPLOAD ..." line, split into words, or None on a
+        timeout. Anything else the board says is passed over."""
+        deadline = time.monotonic() + timeout
+        while True:
+            while b"\n" in self.pending:
+                line, self.pending = self.pending.split(b"\n", 1)
+                words = line.decode("ascii", "replace").split()
+                if words[:1] == ["UPLOAD"]:
+                    return words[1:]
+            if time.monotonic() > deadline:
+                return None
+            chunk = self._read()
+            if not chunk:
+                time.sleep(0.002)
+            self.pending += chunk
+
+
+def exchange(port, data, expect):
+    """Send a frame until the board says it has expect tile bytes."""
+    for _ in range(TRIES):
+        port.write(data)
+        while True:
+            words = port.reply(REPLY_TIMEOUT)
+            if words is None or words == ["BAD"]:
+                break  # send it again
+            if words == ["NO"]:
+                raise UploadError("the board refused the level; try again")
+            if words[0] == "OK" and len(words) == 2 and words[1] == str(expect):
+                return
+            # an answer to an earlier try: wait for ours
+    raise UploadError("no answer from the board (is it on the menu?)")
+
+
+def upload(port, tiles, length, rows, log=print):
+    total = len(tiles)
+    start = time.monotonic()
+    exchange(port, frame(BEGIN, struct.pack("<HB", length, rows)), 0)
+    for offset in range(0, total, CHUNK):
+        chunk = tiles[offset:offset + CHUNK]
+        exchange(port, frame(DATA, struct.pack("<H", offset) + chunk), offset + len(chunk))
+    exchange(port, frame(END, struct.pack("<H", crc16(tiles))), total)
+    log("%d columns sent in %.2f s" % (length, time.monotonic() - start))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Send a level to the board over its serial port.")
+    parser.add_argument("port", help="serial port, or the stand-in's pseudo-terminal")
+    parser.add_argument("level", help="level image or level file")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    src = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "src")
+    try:
+        rows = asset_compiler.level_rows(src)
+        tiles, length = load_level(args.level, rows)
+        most = (PAGE_BYTES - HEADER) // rows
+        if not 0 < length <= most:
+            raise UploadError("%s: %d columns, uploads take 1 to %d" % (args.level, length, most))
+        upload(Port(args.port, args.baud), tiles, length, rows)
+    except (UploadError, asset_compiler.AssetError, OSError) as e:
+        sys.exit("level_upload: %s" % e)
+
+
+if __name__ == "__main__":
+    main()
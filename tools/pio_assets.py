@@ -0,0 +1,15 @@
+# PlatformIO extra script: runs tools/asset_compiler.py before every build so
+# the sprite and level sources follow the images in assets/.  Only changed
+# images are converted and only changed sources are rewritten, so a build
+# with no asset changes recompiles nothing because of it.
+import os
+import sys
+
+Import("env")
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))
+import asset_compiler
+
+if asset_compiler.run(env.subst("$PROJECT_DIR"),
+                      cache=os.path.join(env.subst("$PROJECT_WORKSPACE_DIR"), "asset_cache.json")) != 0:
+    env.Exit(1)
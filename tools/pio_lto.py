@@ -0,0 +1,7 @@
+# PlatformIO extra script: with LTO the code is generated at link time, so
+# the link needs -flto and the same -O level the objects were compiled with.
+# build_flags only reach the compiler, so copy them across.
+Import("env")
+
+flags = [f for f in env.Flatten(env.get("CCFLAGS", [])) if f == "-flto" or f.startswith("-O")]
+env.Append(LINKFLAGS=flags)
@@ -0,0 +1,34 @@
+# PlatformIO extra script: runs tools/size_budget.py on the linker map after
+# every link and fails the build if a budget is exceeded.  Budgets come from
+# the env in platformio.ini:
+#   custom_flash_budget, custom_ram_budget, custom_min_stack
+# The previous build's numbers are kept in $BUILD_DIR/size_report.json so
+# each build prints what it changed.
+import os
+import sys
+
+Import("env")
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))
+import size_budget
+
+env.Append(LINKFLAGS=["-Wl,-Map,${BUILD_DIR}/${PROGNAME}.map"])
+
+
+def option(name, default):
+    return int(env.GetProjectOption(name, default))
+
+
+def check_budget(target, source, env):
+    build_dir = env.subst("$BUILD_DIR")
+    report = os.path.join(build_dir, "size_report.json")
+    budgets = {
+        "flash": option("custom_flash_budget", 32768),
+        "ram": option("custom_ram_budget", 4096),
+        "min_stack": option("custom_min_stack", 1024),
+    }
+    return size_budget.run(os.path.join(build_dir, env.subst("${PROGNAME}.map")),
+                           env.subst("$PROJECT_SRC_DIR"), budgets, previous=report, save=report)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", check_budget)
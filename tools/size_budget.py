@@ -0,0 +1,265 @@
+"""Flash and RAM budget check from the linker map.
+
+Usage:
+    python size_budget.py <firmware.map> [--src src] [--flash 32768] [--ram 4096]
+                          [--min-stack 1024] [--previous size_report.json]
+                          [--save size_report.json] [--top 15]
+
+Every input section in the map is put in a module:
+- sprites: arrays named in src/sprite_map.h
+- font: arrays named in src/font5x7.h
+- levels: levels.c and its levelTiles data (src/levels/level_data.h)
+- soft-float: libgcc float/double helpers
+- libgcc / libc: the rest of the toolchain libraries
+- code: everything else that runs from flash
+- const: other read-only data
+- ram: other .data/.bss
+
+Prints the totals, the per-module split, the asset pools from
+src/asset_manifest.json (written by tools/asset_compiler.py) and the
+largest symbols. If
+--previous names the JSON saved by the last run, it also prints what
+changed. Exits with status 1 when a budget is blown, which is what
+fails the build when tools/pio_size_budget.py runs this after linking.
+
+Flash is everything loaded into flash: code, rodata and the initial
+values of .data. RAM is .data + .bss, and must leave at least
+--min-stack bytes of the RAM budget free for the stack.
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+# Output sections that take up room in flash and/or RAM
+FLASH_SECTIONS = (".isr_vector", ".text", ".rodata", ".ARM.extab", ".ARM", ".ARM.exidx",
+                  ".preinit_array", ".init_array", ".fini_array", ".data")
+RAM_SECTIONS = (".data", ".bss")
+
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)")
+OUTPUT_NAME_RE = re.compile(r"^(\.\S+)\s*$")
+INPUT_RE = re.compile(r"^ (\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$")
+INPUT_NAME_RE = re.compile(r"^ (\.\S+)\s*$")
+INPUT_CONT_RE = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$")
+ARRAY_RE = re.compile(r"const\s+\w+\s+(\w+)\s*\[")
+ARCHIVE_RE = re.compile(r"([^/\\]+)\.a\(([^)]+)\)")
+FLOAT_MEMBER_RE = re.compile(r"(sf|df|fp|float|fix)", re.I)
+
+
+def array_names(path):
+    try:
+        with open(path) as fh:
+            return set(ARRAY_RE.findall(fh.read()))
+    except OSError:
+        return set()
+
+
+def parse_map(path):
+    """Yield (output section, input section, size, object) for every input
+    section with a non-zero size in the memory map part of the file."""
+    with open(path) as fh:
+        lines = fh.read().splitlines()
+    try:
+        start = next(i for i, l in enumerate(lines) if l.startswith("Linker script and memory map"))
+    except StopIteration:
+        sys.exit("%s doesn't look like a GNU ld map" % path)
+    output = None
+    pending_output = None
+    pending_input = None
+    for line in lines[start + 1:]:
+        if line.startswith("/DISCARD/"):
+            output = None
+            continue
+        if pending_output is not None:
+            m = re.match(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)", line)
+            output = pending_output if m else None
+            pending_output = None
+            continue
+        m = OUTPUT_RE.match(line)
+        if m:
+            output = m.group(1)
+            continue
+        m = OUTPUT_NAME_RE.match(line)
+        if m:
+            pending_output = m.group(1)  # long name: address and size on the next line
+            continue
+        if output is None:
+            continue
+        if pending_input is not None:
+            m = INPUT_CONT_RE.match(line)
+            if m:
+                size = int(m.group(2), 16)
+                if size:
+                    yield output, pending_input, size, m.group(3).strip()
+            pending_input = None
+            continue
+        m = INPUT_NAME_RE.match(line)
+        if m:
+            pending_input = m.group(1)
+            continue
+        m = INPUT_RE.match(line)
+        if m and m.group(1).startswith("."):
+            size = int(m.group(3), 16)
+            if size:
+                yield output, m.group(1), size, m.group(4).strip()
+        elif m and m.group(1) == "COMMON":
+            size = int(m.group(3), 16)
+            if size:
+                yield output, "COMMON", size, m.group(4).strip()
+
+
+def symbol_of(section, obj):
+    # -ffunction-sections / -fdata-sections name each section after its symbol
+    for prefix in (".text.startup.", ".text.", ".rodata.", ".data.", ".bss.", ".sdata.", ".sbss."):
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return "%s(%s)" % (os.path.basename(obj), section)
+
+
+def classify(output, symbol, obj, sprites, font):
+    m = ARCHIVE_RE.search(obj)
+    if m:
+        lib, member = m.groups()
+        if lib == "libgcc":
+            return "soft-float" if FLOAT_MEMBER_RE.search(member) else "libgcc"
+        return "libc"
+    base = os.path.basename(obj)
+    if symbol in sprites:
+        return "sprites"
+    if symbol in font:
+        return "font"
+    if base.startswith("levels") or symbol.startswith("level_"):
+        return "levels"
+    if output in RAM_SECTIONS:
+        return "ram"
+    if output == ".rodata":
+        return "const"
+    return "code"
+
+
+def measure(map_path, src):
+    sprites = array_names(os.path.join(src, "sprite_map.h"))
+    font = array_names(os.path.join(src, "font5x7.h"))
+    symbols = {}
+    modules = {}
+    flash = ram = 0
+    for output, section, size, obj in parse_map(map_path):
+        in_flash = output in FLASH_SECTIONS
+        in_ram = output in RAM_SECTIONS
+        if not in_flash and not in_ram:
+            continue
+        symbol = symbol_of(section, obj)
+        module = classify(output, symbol, obj, sprites, font)
+        entry = modules.setdefault(module, {"flash": 0, "ram": 0})
+        sym = symbols.setdefault(symbol, {"module": module, "flash": 0, "ram": 0})
+        if in_flash:
+            flash += size
+            entry["flash"] += size
+            sym["flash"] += size
+        if in_ram:
+            ram += size
+            entry["ram"] += size
+            sym["ram"] += size
+    return {"flash": flash, "ram": ram, "modules": modules, "symbols": symbols}
+
+
+def signed(n):
+    return "%+d" % n if n else "0"
+
+
+def asset_manifest(src):
+    try:
+        with open(os.path.join(src, "asset_manifest.json")) as fh:
+            return json.load(fh)
+    except (OSError, ValueError):
+        return None
+
+
+def report(now, before, budgets, top, assets=None):
+    print("flash %6d / %d bytes (%.1f%%)" % (now["flash"], budgets["flash"], 100.0 * now["flash"] / budgets["flash"]))
+    print("ram   %6d / %d bytes, %d left for the stack (minimum %d)"
+          % (now["ram"], budgets["ram"], budgets["ram"] - now["ram"], budgets["min_stack"]))
+    if before:
+        print("      change since last build: flash %s, ram %s"
+              % (signed(now["flash"] - before["flash"]), signed(now["ram"] - before["ram"])))
+    print()
+    print("module          flash     ram%s" % ("   d.flash   d.ram" if before else ""))
+    for name in sorted(now["modules"], key=lambda n: -now["modules"][n]["flash"] - now["modules"][n]["ram"]):
+        m = now["modules"][name]
+        line = "%-12s %8d %7d" % (name, m["flash"], m["ram"])
+        if before:
+            old = before["modules"].get(name, {"flash": 0, "ram": 0})
+            line += " %9s %7s" % (signed(m["flash"] - old["flash"]), signed(m["ram"] - old["ram"]))
+        print(line)
+    if assets:
+        print()
+        print("asset pool        bytes  shared  contents")
+        for name, pool in sorted(assets["pools"].items()):
+            items = [a for a in assets["assets"] if a["pool"] == name]
+            kinds = sorted(set(a["kind"] for a in items))
+            print("%-14s %8d %7d  %s" % (name, pool["bytes"], pool["unpooled_bytes"] - pool["bytes"],
+                                         ", ".join("%d %ss" % (sum(a["kind"] == k for a in items), k) for k in kinds)))
+    print()
+    print("largest symbols")
+    ranked = sorted(now["symbols"].items(), key=lambda kv: -(kv[1]["flash"] + kv[1]["ram"]))
+    for name, s in ranked[:top]:
+        print("  %6d %5d  %-10s %s" % (s["flash"], s["ram"], s["module"], name))
+    if before:
+        changed = []
+        for name in set(now["symbols"]) | set(before["symbols"]):
+            a = before["symbols"].get(name, {"flash": 0, "ram": 0})
+            b = now["symbols"].get(name, {"flash": 0, "ram": 0})
+            d = (b["flash"] - a["flash"], b["ram"] - a["ram"])
+            if d != (0, 0):
+                changed.append((name, d))
+        if changed:
+            print()
+            print("changed symbols")
+            for name, d in sorted(changed, key=lambda c: -abs(c[1][0]) - abs(c[1][1]))[:top]:
+                print("  flash %6s ram %5s  %s" % (signed(d[0]), signed(d[1]), name))
+
+
+def check(now, budgets):
+    errors = []
+    if now["flash"] > budgets["flash"]:
+        errors.append("flash %d bytes is over the %d byte budget" % (now["flash"], budgets["flash"]))
+    if now["ram"] > budgets["ram"] - budgets["min_stack"]:
+        errors.append("static RAM %d bytes leaves less than %d bytes of stack in %d"
+                      % (now["ram"], budgets["min_stack"], budgets["ram"]))
+    return errors
+
+
+def run(map_path, src, budgets, previous=None, save=None, top=15):
+    now = measure(map_path, src)
+    before = None
+    if previous and os.path.exists(previous):
+        with open(previous) as fh:
+            before = json.load(fh)
+    report(now, before, budgets, top, asset_manifest(src))
+    if save:
+        with open(save, "w") as fh:
+            json.dump(now, fh, indent=1, sort_keys=True)
+    errors = check(now, budgets)
+    for e in errors:
+        print("BUDGET EXCEEDED: " + e)
+    return 1 if errors else 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("map")
+    ap.add_argument("--src", default="src", help="source directory, for the sprite and font names")
+    ap.add_argument("--flash", type=int, default=32768)
+    ap.add_argument("--ram", type=int, default=4096)
+    ap.add_argument("--min-stack", type=int, default=1024)
+    ap.add_argument("--previous", help="JSON from an earlier run to diff against")
+    ap.add_argument("--save", help="write this run's JSON here")
+    ap.add_argument("--top", type=int, default=15)
+    args = ap.parse_args()
+    budgets = {"flash": args.flash, "ram": args.ram, "min_stack": args.min_stack}
+    sys.exit(run(args.map, args.src, budgets, args.previous, args.save, args.top))
+
+
+if __name__ == "__main__":
+    main()
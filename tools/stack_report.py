@@ -0,0 +1,203 @@
+"""Worst-case stack usage by call path, from gcc's -fstack-usage output.
+
+Usage:
+    python stack_report.py <build dir> [--elf firmware.elf] [--objdump PATH]
+
+Build with env nucleo_f031k6_stack first (it adds -fstack-usage), then point
+this at .pio/build/nucleo_f031k6_stack. Frame sizes come from the .su files
+next to the objects. The call graph comes from disassembling the ELF: every
+bl/b to a symbol is an edge. For each root (main and every interrupt
+handler) the script prints the deepest call path with the size of each
+frame.
+
+The worst case for the whole device is deepest main path + deepest
+handler + the 32 byte exception frame. Every IRQ runs at the same NVIC
+priority, so handlers don't nest. That figure is compared with the room
+between the end of .bss and the top of RAM.
+
+Things the number can't see are listed separately: functions with no .su
+entry (libgcc, the startup code), indirect calls, dynamically sized frames
+and recursion.
+"""
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+EXCEPTION_FRAME = 32  # r0-r3, r12, lr, pc, xpsr stacked on interrupt entry
+
+FUNC_RE = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+# bl/b on ARM, call/jmp when trying the script on a host build
+CALL_RE = re.compile(r"\s(bl|blx|b|b\.n|b\.w|call|callq|jmp|jmpq)\s+[0-9a-f]+ <([^>]+)>")
+INDIRECT_RE = re.compile(r"\s(blx\s+r\d+|bx\s+r[0-9]\b|call\s+\*|callq\s+\*)")
+SYMBOL_RE = re.compile(r"^([0-9a-f]+)\s.*\s(\S+)$")
+
+
+def find_objdump(given):
+    if given:
+        return given
+    for name in ("arm-none-eabi-objdump",):
+        path = shutil.which(name)
+        if path:
+            return path
+    pio = os.path.expanduser("~/.platformio/packages/toolchain-gccarmnoneeabi/bin/arm-none-eabi-objdump")
+    if os.path.exists(pio):
+        return pio
+    sys.exit("can't find arm-none-eabi-objdump, pass --objdump")
+
+
+def read_su(build_dir):
+    """name -> (bytes, qualifiers). Static functions with the same name in
+    different files keep the larger frame."""
+    frames = {}
+    for root, _, files in os.walk(build_dir):
+        for f in files:
+            if not f.endswith(".su"):
+                continue
+            with open(os.path.join(root, f)) as fh:
+                for line in fh:
+                    parts = line.rstrip("\n").split("\t")
+                    if len(parts) < 3:
+                        continue
+                    name = parts[0].rsplit(":", 1)[-1]
+                    size = int(parts[1])
+                    if name not in frames or frames[name][0] < size:
+                        frames[name] = (size, parts[2])
+    return frames
+
+
+def read_calls(objdump, elf):
+    out = subprocess.run([objdump, "-d", "--no-show-raw-insn", elf],
+                         stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    calls = {}
+    indirect = set()
+    current = None
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            current = m.group(2)
+            calls.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        m = CALL_RE.search(line)
+        if m:
+            target = m.group(2)
+            # Branches inside a function show as <name+0x1c>
+            if "+" in target or target == current:
+                continue
+            calls[current].add(target.split("@")[0])
+        elif INDIRECT_RE.search(line):
+            indirect.add(current)
+    return calls, indirect
+
+
+def read_symbols(objdump, elf):
+    out = subprocess.run([objdump, "-t", elf], stdout=subprocess.PIPE,
+                         universal_newlines=True, check=True).stdout
+    syms = {}
+    for line in out.splitlines():
+        m = SYMBOL_RE.match(line)
+        if m:
+            syms[m.group(2)] = int(m.group(1), 16)
+    return syms
+
+
+class Walker:
+    def __init__(self, frames, calls):
+        self.frames = frames
+        self.calls = calls
+        self.memo = {}
+        self.unknown = set()
+        self.dynamic = set()
+        self.recursive = set()
+
+    def frame(self, name):
+        if name not in self.frames:
+            self.unknown.add(name)
+            return 0
+        size, qual = self.frames[name]
+        if "dynamic" in qual:
+            self.dynamic.add(name)
+        return size
+
+    def worst(self, name, stack=()):
+        """(total bytes, [(function, frame bytes), ...]) for the deepest path"""
+        if name in stack:
+            self.recursive.add(name)
+            return 0, []
+        if name in self.memo:
+            return self.memo[name]
+        best = (0, [])
+        for callee in sorted(self.calls.get(name, ())):
+            candidate = self.worst(callee, stack + (name,))
+            if candidate[0] > best[0]:
+                best = candidate
+        own = self.frame(name)
+        result = (own + best[0], [(name, own)] + best[1])
+        self.memo[name] = result
+        return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("build_dir")
+    ap.add_argument("--elf", help="default: <build dir>/firmware.elf")
+    ap.add_argument("--objdump")
+    ap.add_argument("--root", action="append", default=[],
+                    help="extra entry point to report (main and *_Handler/*_IRQHandler are always included)")
+    args = ap.parse_args()
+
+    elf = args.elf or os.path.join(args.build_dir, "firmware.elf")
+    objdump = find_objdump(args.objdump)
+    frames = read_su(args.build_dir)
+    if not frames:
+        sys.exit("no .su files under %s (was it built with -fstack-usage?)" % args.build_dir)
+    calls, indirect = read_calls(objdump, elf)
+    walker = Walker(frames, calls)
+
+    handlers = sorted(n for n in calls if n.endswith("_Handler") or n.endswith("_IRQHandler"))
+    roots = ["main"] + args.root
+    for name in roots + handlers:
+        total, path = walker.worst(name)
+        print("%-24s %5d bytes" % (name, total))
+        for fn, size in path:
+            print("    %5d  %s" % (size, fn))
+
+    main_total = walker.worst("main")[0]
+    worst_handler = max([walker.worst(h)[0] for h in handlers] or [0])
+    total = main_total + worst_handler + EXCEPTION_FRAME
+    print()
+    print("worst case: main %d + interrupt %d + exception frame %d = %d bytes"
+          % (main_total, worst_handler, EXCEPTION_FRAME, total))
+
+    syms = read_symbols(objdump, elf)
+    if "_estack" in syms and "_ebss" in syms:
+        room = syms["_estack"] - syms["_ebss"]
+        print("stack room (_ebss to _estack): %d bytes, %d spare" % (room, room - total))
+        if total > room:
+            print("WARNING: worst case doesn't fit")
+
+    reached = set()
+    for name in roots + handlers:
+        todo = [name]
+        while todo:
+            fn = todo.pop()
+            if fn not in reached:
+                reached.add(fn)
+                todo.extend(calls.get(fn, ()))
+    notes = [
+        ("no stack information (counted as 0)", sorted(walker.unknown & reached)),
+        ("indirect calls (callees not followed)", sorted(indirect & reached)),
+        ("dynamically sized frames", sorted(walker.dynamic)),
+        ("recursion (cut at the repeat)", sorted(walker.recursive)),
+    ]
+    for title, names in notes:
+        if names:
+            print("%s: %s" % (title, ", ".join(names)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,110 @@
+"""Decode the binary telemetry stream (src/telemetry.h) into CSV.
+
+Usage:
+    python telemetry_decode.py <capture.bin | serial port> [out.csv] [--baud 115200]
+
+Reads a raw capture file, or a serial port if the path looks like one
+(needs pyserial). Runs until EOF or Ctrl-C. Records with a bad CRC are
+skipped and the decoder resyncs on the next sync byte. Gaps in the sequence
+number (records the device dropped because its TX buffer was full) are
+reported on stderr.
+"""
+import argparse
+import struct
+import sys
+
+SYNC = 0xA5
+FRAME = 0x01
+FRAME_SIZE = 17
+FRAME_FORMAT = "<BHHHHiBB"  # type, seq, frame_us, bus_bytes, deaths, scroll, height, flags
+
+FLAG_IN_AIR = 0x01
+FLAG_WON = 0x02
+FLAG_QUALITY_SHIFT = 2
+FLAG_QUALITY_MASK = 0x1c
+
+COLUMNS = ["seq", "frame_us", "bus_bytes", "deaths", "scroll_px", "height_px", "in_air", "won", "quality"]
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def decode(buf):
+    """Yield (consumed, record) pairs from a byte buffer; record is None for
+    skipped garbage. Stops when the buffer doesn't hold a whole record."""
+    i = 0
+    while True:
+        start = buf.find(bytes([SYNC]), i)
+        if start < 0:
+            yield len(buf), None
+            return
+        if start + FRAME_SIZE > len(buf):
+            yield start, None
+            return
+        rec = buf[start:start + FRAME_SIZE]
+        if rec[1] != FRAME or crc8(rec[1:FRAME_SIZE - 1]) != rec[FRAME_SIZE - 1]:
+            i = start + 1
+            continue
+        _, seq, frame_us, bus, deaths, scroll, height, flags = struct.unpack(FRAME_FORMAT, rec[1:FRAME_SIZE - 1])
+        i = start + FRAME_SIZE
+        yield i, [seq, frame_us, bus, deaths, scroll, height,
+                  int(bool(flags & FLAG_IN_AIR)), int(bool(flags & FLAG_WON)),
+                  (flags & FLAG_QUALITY_MASK) >> FLAG_QUALITY_SHIFT]
+
+
+def open_source(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        port = serial.Serial(path, baud, timeout=0.5)
+        return port.read
+    f = open(path, "rb")
+    return f.read
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the binary telemetry stream into CSV.")
+    parser.add_argument("source", help="raw capture file or serial port")
+    parser.add_argument("output", nargs="?", help="CSV file (default stdout)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    live = args.source.startswith("/dev/") or args.source.upper().startswith("COM")
+    read = open_source(args.source, args.baud)
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write(",".join(COLUMNS) + "\n")
+
+    pending = b""
+    last_seq = None
+    records = 0
+    try:
+        while True:
+            chunk = read(4096)
+            if not chunk:
+                if not live:
+                    break
+                continue
+            pending += chunk
+            consumed = 0
+            for consumed, rec in decode(pending):
+                if rec is None:
+                    continue
+                seq = rec[0]
+                if last_seq is not None and seq != (last_seq + 1) & 0xFFFF:
+                    print(f"gap: {(seq - last_seq - 1) & 0xFFFF} record(s) dropped before seq {seq}", file=sys.stderr)
+                last_seq = seq
+                out.write(",".join(str(v) for v in rec) + "\n")
+                records += 1
+            pending = pending[consumed:]
+    except KeyboardInterrupt:
+        pass
+    print(f"{records} records", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()